@@ -0,0 +1,261 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+
+#include "common.hpp"
+#include "defines.hpp"
+#include "fwd.hpp"
+
+// the stream queries are host runtime API calls so they do not require the
+// device compiler
+#if defined(KOKKOS_ENABLE_CUDA)
+#  include <cuda_runtime_api.h>
+#endif
+
+#if defined(KOKKOS_ENABLE_HIP)
+#  include <hip/hip_runtime_api.h>
+#endif
+
+//----------------------------------------------------------------------------//
+//
+//                                  Futures
+//
+//----------------------------------------------------------------------------//
+/// \class async_future
+/// \brief Lightweight handle to work submitted to an execution space instance.
+/// Completion is established by fencing only that instance (never a global
+/// Kokkos::fence()) and the value of the operation, if any, is materialized
+/// after the fence.
+///
+class async_future {
+ public:
+  using fence_func_t    = std::function<void()>;
+  using query_func_t    = std::function<bool()>;
+  using value_func_t    = std::function<py::object()>;
+  using callback_func_t = std::function<void()>;
+
+  async_future() = default;
+  async_future(fence_func_t, query_func_t, value_func_t);
+
+  // blocks until the work has completed. Does not touch the GIL
+  void fence() const;
+  // blocks until the work has completed with the GIL released
+  void wait() const;
+  // non-blocking completion query. Execution spaces without a query (see
+  // get_async_query) only report completion once the future was fenced
+  bool done() const;
+  // waits for completion and returns the value of the operation
+  py::object result() const;
+  // returns a future resolving to the value of _func(result()). _func is
+  // invoked from the waiter thread and when it returns a future, the
+  // returned future resolves once that future has completed
+  async_future then(py::function _func) const;
+
+ private:
+  friend void add_done_callback(const async_future &, callback_func_t);
+
+  // a future without work of its own which completes when resolved
+  static async_future deferred();
+  // completes a deferred future with the value returned by _get or the
+  // exception it raises. When the value is a future, the deferred future
+  // completes with its result once it has completed. Requires the GIL
+  void resolve(const value_func_t &_get) const;
+  // retains the callback until a deferred future which has not completed
+  // is resolved. Returns false for all other futures
+  bool defer_callback(callback_func_t &_func) const;
+
+  struct state;
+  std::shared_ptr<state> m_state = {};
+};
+
+//----------------------------------------------------------------------------//
+//  invokes _func with the GIL held from a background waiter thread once the
+//  future has completed. The waiter thread fences without holding the GIL
+//
+void add_done_callback(const async_future &_future,
+                       std::function<void()> _func);
+
+//----------------------------------------------------------------------------//
+//  host backends which complete all work before returning from a dispatch
+//
+template <typename Tp>
+struct is_synchronous_space : std::false_type {};
+
+template <>
+struct is_synchronous_space<Kokkos::Serial> : std::true_type {};
+
+template <>
+struct is_synchronous_space<Kokkos::OpenMP> : std::true_type {};
+
+template <>
+struct is_synchronous_space<Kokkos::Threads> : std::true_type {};
+
+//----------------------------------------------------------------------------//
+
+//  fence-free completion query of the work submitted to an execution space
+//  instance. Kokkos has no portable query, so the synchronous host backends
+//  are always complete and CUDA and HIP query their stream. The other
+//  backends (e.g. SYCL, OpenMPTarget, HPX) have no query: done() is only
+//  true after wait(), result(), or once the waiter thread has fenced them
+//
+template <typename ExecT>
+async_future::query_func_t get_async_query(const ExecT &) {
+  IF_CONSTEXPR(is_synchronous_space<ExecT>::value) {
+    return []() { return true; };
+  }
+  return async_future::query_func_t{};
+}
+
+#if defined(KOKKOS_ENABLE_CUDA)
+inline async_future::query_func_t get_async_query(const Kokkos::Cuda &_space) {
+  return [_space]() {
+    return cudaStreamQuery(_space.cuda_stream()) == cudaSuccess;
+  };
+}
+#endif
+
+#if defined(KOKKOS_ENABLE_HIP)
+inline async_future::query_func_t get_async_query(
+    const Kokkos::Experimental::HIP &_space) {
+  return [_space]() {
+    return hipStreamQuery(_space.hip_stream()) == hipSuccess;
+  };
+}
+#endif
+
+//----------------------------------------------------------------------------//
+
+template <typename ExecT>
+async_future make_async_future(const ExecT &_space,
+                               async_future::value_func_t _value = {}) {
+  return async_future{[_space]() { _space.fence(); }, get_async_query(_space),
+                      std::move(_value)};
+}
+
+//----------------------------------------------------------------------------//
+//  converts an optional python execution space argument into an instance
+//
+template <typename ExecT>
+ExecT get_execution_space_instance(py::object _space) {
+  if (_space.is_none()) return ExecT{};
+  return _space.cast<ExecT>();
+}
+
+//----------------------------------------------------------------------------//
+//
+//                          Asynchronous view operations
+//
+//----------------------------------------------------------------------------//
+
+namespace Impl {
+template <typename Tp, typename MemSp>
+using flat_view_t =
+    Kokkos::View<Tp *, MemSp, Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+
+// one-dimensional alias of the allocation so that the operations below are
+// instantiated once per data type and memory space instead of once per view
+template <typename ViewT>
+auto get_flat_view(const ViewT &_v) {
+  using value_type   = typename ViewT::non_const_value_type;
+  using memory_space = typename ViewT::memory_space;
+  if (!_v.span_is_contiguous())
+    throw std::runtime_error(
+        "Error! Asynchronous view operations require a contiguous view");
+  return flat_view_t<value_type, memory_space>{
+      reinterpret_cast<value_type *>(_v.data()), _v.span()};
+}
+
+template <typename ReducerT, typename ViewT>
+struct async_reduce_functor {
+  using value_type = typename ReducerT::value_type;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t i, value_type &_val) const {
+    m_reducer.join(_val, m_data(i));
+  }
+
+  ReducerT m_reducer;
+  ViewT m_data;
+};
+}  // namespace Impl
+
+template <typename ExecT, typename FlatT>
+async_future fill_async(const ExecT &_space, const FlatT &_data,
+                        typename FlatT::const_value_type &_value) {
+  {
+    py::gil_scoped_release _nogil{};
+    Kokkos::deep_copy(_space, _data, _value);
+  }
+  return make_async_future(_space);
+}
+
+template <template <typename, typename> class ReducerT, typename ExecT,
+          typename FlatT>
+async_future reduce_async(const ExecT &_space, const FlatT &_data) {
+  using value_type    = typename FlatT::non_const_value_type;
+  using result_view_t = Kokkos::View<value_type, Kokkos::HostSpace>;
+  using reducer_t     = ReducerT<value_type, Kokkos::HostSpace>;
+  using functor_t     = Impl::async_reduce_functor<reducer_t, FlatT>;
+
+  auto _result = result_view_t{"pykokkos_reduce_async"};
+  {
+    py::gil_scoped_release _nogil{};
+    auto _reducer = reducer_t{_result};
+    Kokkos::parallel_reduce(
+        "pykokkos_reduce_async",
+        Kokkos::RangePolicy<ExecT>(_space, 0, _data.extent(0)),
+        functor_t{_reducer, _data}, _reducer);
+  }
+  return make_async_future(_space,
+                           [_result]() { return py::cast(_result()); });
+}
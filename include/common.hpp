@@ -65,6 +65,10 @@ namespace py = pybind11;
 #include <sstream>
 #include <string>
 #include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_set>
+#include <vector>
 
 #if defined(ENABLE_DEMANGLE)
 #  include <cxxabi.h>
@@ -130,17 +134,53 @@ std::string join(const std::string &delim, Args &&...args) {
 
 //----------------------------------------------------------------------------//
 
-std::set<std::string> &get_existing_pyclass_names();
+std::unordered_set<std::type_index> &get_existing_pyclass_types();
 
 //----------------------------------------------------------------------------//
 
+// returns false if a python class was already created for the type
 template <typename Tp>
 inline auto add_pyclass() {
-  if (get_existing_pyclass_names().count(demangle<Tp>()) > 0) return false;
-  get_existing_pyclass_names().insert(demangle<Tp>());
-  return true;
+  return get_existing_pyclass_types().emplace(typeid(Tp)).second;
 }
 
 //----------------------------------------------------------------------------//
 
 bool debug_output();
+
+//----------------------------------------------------------------------------//
+//
+//  Lazy registration: when the PYKOKKOS_BASE_LAZY_REGISTRATION environment
+//  variable is enabled, the classes for the view and atomic variants are not
+//  created at import time. A thunk is recorded under the python name and the
+//  C++ type instead and it is invoked on the first lookup of that name on the
+//  module (or when another class which returns that type is created).
+//
+//----------------------------------------------------------------------------//
+
+using pyclass_thunk_t = void (*)(py::module &);
+
+bool lazy_registration();
+void add_lazy_pyclass(const std::string &, const std::type_info &,
+                      pyclass_thunk_t);
+bool register_lazy_pyclass(py::module &, const std::string &);
+bool register_lazy_pyclass(py::module &, const std::type_info &);
+size_t register_all_pyclasses(py::module &);
+std::vector<std::string> get_lazy_pyclass_names();
+
+// VariantT provides the class type, the python name and the function which
+// creates the class
+template <typename VariantT>
+inline void generate_pyclass(py::module &_mod) {
+  if (lazy_registration())
+    add_lazy_pyclass(VariantT::name(), typeid(typename VariantT::type),
+                     &VariantT::generate);
+  else
+    VariantT::generate(_mod);
+}
+
+// makes sure the class for a type is created if it was deferred
+template <typename Tp>
+inline void ensure_pyclass(py::module &_mod) {
+  if (lazy_registration()) register_lazy_pyclass(_mod, typeid(Tp));
+}
@@ -103,6 +103,15 @@ struct is_available : std::true_type {};
 template <typename Tp>
 struct is_implicit : std::false_type {};
 
+//----------------------------------------------------------------------------//
+//  this is used to detect complex data types
+//
+template <typename Tp>
+struct is_complex : std::false_type {};
+
+template <typename Tp>
+struct is_complex<Kokkos::complex<Tp>> : std::true_type {};
+
 //----------------------------------------------------------------------------//
 //  this is used to convert Kokkos::Device<ExecSpace, MemSpace> to MemSpace
 //
@@ -162,3 +171,11 @@ using kokkos_python_view_type = Kokkos::Experimental::python_view_type<Tp>;
 template <typename Tp>
 using kokkos_python_view_type_t =
     typename Kokkos::Experimental::python_view_type<Tp>::type;
+
+//----------------------------------------------------------------------------//
+//  the python view class for a one-dimensional view in a memory space, e.g.
+//  the keys, indices, and values passed to the bulk container operations
+//
+template <typename Tp, typename Sp>
+using kokkos_python_view_1d_t = kokkos_python_view_type_t<
+    view_type_t<Kokkos::View<Tp *>, Kokkos::LayoutRight, Sp>>;
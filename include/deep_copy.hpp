@@ -47,6 +47,7 @@
 #include <Kokkos_Core.hpp>
 #include <Kokkos_DynRankView.hpp>
 
+#include "async.hpp"
 #include "common.hpp"
 #include "concepts.hpp"
 #include "fwd.hpp"
@@ -290,6 +291,19 @@ struct PYKOKKOS_HIDDEN deep_copy {
     m_module.def("deep_copy", [](Tp& _lhs, const Up& _rhs) {
       return Kokkos::deep_copy(_lhs, _rhs);
     });
+    m_module.def(
+        "deep_copy_async",
+        [](Tp& _lhs, const Up& _rhs, py::object _space) {
+          using exec_t = typename Tp::execution_space;
+          auto _inst   = get_execution_space_instance<exec_t>(_space);
+          {
+            py::gil_scoped_release _nogil{};
+            Kokkos::deep_copy(_inst, _lhs, _rhs);
+          }
+          return make_async_future(_inst);
+        },
+        "Deep copy on an execution space instance and return a Future",
+        py::arg("src"), py::arg("space") = py::none());
   }
 
   template <typename Tp, typename Up>
@@ -133,13 +133,20 @@
     using type = __VA_ARGS__;           \
   };
 
+#define VIEW_DATA_TYPE_IDX(TYPE, ENUM_ID)   \
+  template <>                              \
+  struct ViewDataTypeIndex<TYPE> {         \
+    static constexpr auto value = ENUM_ID; \
+  };
+
 #define VIEW_DATA_TYPE(TYPE, ENUM_ID, ...)                        \
   template <>                                                     \
   struct ViewDataTypeSpecialization<ENUM_ID> {                    \
     using type = TYPE;                                            \
     static std::string label() { GET_FIRST_STRING(__VA_ARGS__); } \
     static const auto& labels() { GET_STRING_SET(__VA_ARGS__); }  \
-  };
+  };                                                              \
+  VIEW_DATA_TYPE_IDX(TYPE, ENUM_ID)
 
 #define EXECUTION_SPACE_IDX(EXECUTION_SPACE, ENUM_ID) \
   template <>                                         \
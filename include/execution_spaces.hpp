@@ -46,6 +46,7 @@
 
 #include <Kokkos_Core.hpp>
 
+#include "async.hpp"
 #include "common.hpp"
 #include "concepts.hpp"
 #include "pools.hpp"
@@ -100,6 +101,17 @@ void generate_execution_space(py::module &_mod, const std::string &_name,
 
   py::class_<Sp> _space(_mod, _name.c_str());
   _space.def(py::init([]() { return new Sp{}; }));
+  _space.def(
+      "fence",
+      [](const Sp &_s) {
+        py::gil_scoped_release _nogil{};
+        _s.fence();
+      },
+      "Wait for the work submitted to this instance to complete");
+  _space.def(
+      "fence_async", [](const Sp &_s) { return make_async_future(_s); },
+      "Return a Future which completes when the work currently submitted to "
+      "this instance completes. The Future is awaitable from asyncio");
 
   // Add other constructors with arguments if they exist
   generate_execution_space_init<Sp, SpaceIdx>(_space);
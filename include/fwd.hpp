@@ -203,6 +203,9 @@ struct ViewDataTypeRepr;
 template <size_t DataT>
 struct ViewDataTypeSpecialization;
 
+template <typename Tp>
+struct ViewDataTypeIndex;
+
 template <size_t SpaceT>
 struct ExecutionSpaceSpecialization;
 
@@ -55,8 +55,22 @@ void generate_available(py::module& kokkos);
 void generate_enumeration(py::module& kokkos);
 void generate_view_variants(py::module& kokkos);
 void generate_atomic_variants(py::module& kokkos);
+void generate_dual_view_variants(py::module& kokkos);
+void generate_unordered_map_variants(py::module& kokkos);
+void generate_scatter_view_variants(py::module& kokkos);
+void generate_bitset_variants(py::module& kokkos);
+void generate_growable_view_variants(py::module& kokkos);
+void generate_offset_view_variants(py::module& kokkos);
+void generate_crs_matrix_variants(py::module& kokkos);
 void generate_backend_versions(py::module& kokkos);
 void generate_pool_variants(py::module& kokkos);
 void generate_execution_spaces(py::module& kokkos);
 void generate_complex_dtypes(py::module& kokkos);
+void generate_async(py::module& kokkos);
+void generate_view_cache(py::module& kokkos);
+void generate_view_factory(py::module& kokkos);
+void generate_mapped_file(py::module& kokkos);
+void generate_view_io(py::module& kokkos);
 void destroy_callbacks();
+void finalize_async();
+void finalize_view_cache();
@@ -0,0 +1,160 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <chrono>
+#include <cstdint>
+
+#include "common.hpp"
+
+//----------------------------------------------------------------------------//
+//
+//        Native (C++) tools
+//
+//----------------------------------------------------------------------------//
+
+using device_info_t  = struct Kokkos_Profiling_KokkosPDeviceInfo;
+using space_handle_t = struct Kokkos_Profiling_SpaceHandle;
+
+namespace pykokkos_tools {
+// groups of Kokkos Tools events which a native tool subscribes to
+enum native_event : uint32_t {
+  AllocationEvents = (1 << 0),
+  KernelEvents     = (1 << 1),
+  FenceEvents      = (1 << 2),
+  RegionEvents     = (1 << 3),
+  SectionEvents    = (1 << 4),
+  DeepCopyEvents   = (1 << 5),
+  MarkEvents       = (1 << 6),
+  AllEvents        = (1 << 7) - 1,
+};
+
+enum kernel_kind : uint8_t {
+  ParallelFor = 0,
+  ParallelReduce,
+  ParallelScan,
+  Fence,
+};
+
+// timestamps are from get_timestamp(). end is zero for begin events
+struct kernel_event {
+  const char* name;
+  uint32_t device;
+  kernel_kind kind;
+  uint64_t begin;
+  uint64_t end;
+};
+
+struct deep_copy_event {
+  const char* dst_space;
+  const char* dst_label;
+  const void* dst_ptr;
+  const char* src_space;
+  const char* src_label;
+  const void* src_ptr;
+  uint64_t size;
+  uint64_t begin;
+  uint64_t end;
+};
+
+/// \struct native_tool
+/// \brief Interface for tools implemented in C++. These receive the Kokkos
+/// Tools events from the same trampolines as the python callbacks but never
+/// call into python, i.e. they are safe to use on every event.
+/// Begin and end events (kernels, fences, regions, sections, and deep copies)
+/// are paired by the trampolines so the end events carry the name and the
+/// begin timestamp.
+struct native_tool {
+  virtual ~native_tool() = default;
+
+  virtual void begin_kernel(const kernel_event&) {}
+  virtual void end_kernel(const kernel_event&) {}
+  virtual void push_region(const char*, uint64_t) {}
+  virtual void pop_region(const char*, uint64_t, uint64_t) {}
+  virtual void start_section(const char*, uint32_t, uint64_t) {}
+  virtual void stop_section(const char*, uint32_t, uint64_t, uint64_t) {}
+  virtual void begin_deep_copy(const deep_copy_event&) {}
+  virtual void end_deep_copy(const deep_copy_event&) {}
+  virtual void mark_event(const char*, uint64_t) {}
+
+  virtual void allocate_data(const space_handle_t&, const char*, const void*,
+                             uint64_t) {}
+  virtual void deallocate_data(const space_handle_t&, const char*, const void*,
+                               uint64_t) {}
+};
+
+// native tools must outlive their registration, i.e. they are generally
+// function-local statics. The Kokkos Tools callbacks required by the events
+// are registered while at least one tool or python callback needs them
+void add_native_tool(native_tool* _tool, uint32_t _events);
+void remove_native_tool(native_tool* _tool);
+bool has_native_tool(native_tool* _tool);
+
+// the single instance of a native tool. It is intentionally leaked because
+// the tool may receive events during finalization, after the function-local
+// statics of the module have been destroyed
+template <typename Tp>
+Tp& leaked_instance() {
+  static auto* _instance = new Tp{};
+  return *_instance;
+}
+
+// monotonic timestamp in nanoseconds
+inline uint64_t get_timestamp() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace pykokkos_tools
+
+void generate_memory_tracker(py::module& tools);
+void generate_event_recorder(py::module& tools);
+void generate_chrome_trace(py::module& tools);
+void generate_kernel_timer(py::module& tools);
+void generate_perf_counters(py::module& tools);
+void generate_transfer_ledger(py::module& tools);
+void generate_tuning(py::module& tools);
+void generate_regions(py::module& tools);
@@ -68,17 +68,10 @@ std::string value_to_string(const Kokkos::complex<T> &val) {
          "i)";
 }
 
-// Helper to detect if a type is complex
-template <typename T>
-struct is_complex : std::false_type {};
-
-template <typename T>
-struct is_complex<Kokkos::complex<T>> : std::true_type {};
-
-// this function creates bindings for the atomic type returned to python from
-// views with MemoryTrait<Kokkos::Atomic | ...>
+// the types and the python class name for the atomic type returned to python
+// from views with MemoryTrait<Kokkos::Atomic | ...>
 template <size_t DataIdx, size_t SpaceIdx, size_t DimIdx, size_t LayoutIdx>
-void generate_atomic_variant(py::module &_mod) {
+struct atomic_variant {
   using data_spec_t   = ViewDataTypeSpecialization<DataIdx>;
   using space_spec_t  = MemorySpaceSpecialization<SpaceIdx>;
   using layout_spec_t = MemoryLayoutSpecialization<LayoutIdx>;
@@ -91,119 +84,134 @@ void generate_atomic_variant(py::module &_mod) {
   using ViewT         = view_type_t<Kokkos::View<Vp>, Lp, Sp, Mp>;
   using atomic_type   = typename ViewT::reference_type;
   using value_type    = typename atomic_type::value_type;
+  using type          = atomic_type;
+
+  static std::string name() {
+    return join("_", "KokkosAtomicDataElement", data_spec_t::label(),
+                space_spec_t::label(), layout_spec_t::label(),
+                trait_spec_t::label(), DimIdx + 1);
+  }
+
+  // this function creates bindings for the atomic type
+  static void generate(py::module &_mod) {
+    auto name = atomic_variant::name();
+
+    if (debug_output()) {
+      auto desc =
+          std::string{"Kokkos::Impl::AtomicDataElement<Kokkos::ViewTraits<"} +
+          join(", ", demangle<Vp>(), demangle<Lp>(), demangle<Sp>(),
+               demangle<Mp>()) +
+          ">>";
+      std::cerr << "Registering " << desc << " as python class '" << name
+                << "'..." << std::endl;
+    }
+
+    // class decl
+    py::class_<atomic_type> _atomic{_mod, name.c_str()};
+    _atomic.def(py::init([](value_type *_v) {
+      return new atomic_type{_v, Kokkos::Impl::AtomicViewConstTag{}};
+    }));
 
-  auto name = join("_", "KokkosAtomicDataElement", data_spec_t::label(),
-                   space_spec_t::label(), layout_spec_t::label(),
-                   trait_spec_t::label(), DimIdx + 1);
-
-  auto desc =
-      std::string{"Kokkos::Impl::AtomicDataElement<Kokkos::ViewTraits<"} +
-      join(", ", demangle<Vp>(), demangle<Lp>(), demangle<Sp>(),
-           demangle<Mp>()) +
-      ">>";
-
-  if (debug_output())
-    std::cerr << "Registering " << desc << " as python class '" << name
-              << "'..." << std::endl;
-
-  // class decl
-  py::class_<atomic_type> _atomic{_mod, name.c_str()};
-  _atomic.def(py::init([](value_type *_v) {
-    return new atomic_type{_v, Kokkos::Impl::AtomicViewConstTag{}};
-  }));
-
-  _atomic.def(
-      "inc", [](atomic_type &_obj) { return _obj.inc(); },
-      "Increment the atomic");
-  _atomic.def(
-      "dec", [](atomic_type &_obj) { return _obj.dec(); },
-      "Decrement the atomic");
-  _atomic.def(
-      "__str__",
-      [](atomic_type &_obj) {
-        return value_to_string(static_cast<value_type>(_obj));
-      },
-      "String repr");
-
-  _atomic.def(
-      "__eq__",
-      [](atomic_type &_obj, value_type _v) {
-        return (static_cast<value_type>(_obj) == _v);
-      },
-      py::is_operator());
-  _atomic.def(
-      "__ne__",
-      [](atomic_type &_obj, value_type _v) {
-        return (static_cast<value_type>(_obj) != _v);
-      },
-      py::is_operator());
-
-  // Only bind ordering operators for non-complex types
-  if constexpr (!is_complex<value_type>::value) {
     _atomic.def(
-        "__lt__",
-        [](atomic_type &_obj, value_type _v) {
-          return (static_cast<value_type>(_obj) < _v);
+        "inc", [](atomic_type &_obj) { return _obj.inc(); },
+        "Increment the atomic");
+    _atomic.def(
+        "dec", [](atomic_type &_obj) { return _obj.dec(); },
+        "Decrement the atomic");
+    _atomic.def(
+        "__str__",
+        [](atomic_type &_obj) {
+          return value_to_string(static_cast<value_type>(_obj));
         },
-        py::is_operator());
+        "String repr");
+
     _atomic.def(
-        "__gt__",
+        "__eq__",
         [](atomic_type &_obj, value_type _v) {
-          return (static_cast<value_type>(_obj) > _v);
+          return (static_cast<value_type>(_obj) == _v);
         },
         py::is_operator());
     _atomic.def(
-        "__le__",
+        "__ne__",
         [](atomic_type &_obj, value_type _v) {
-          return (static_cast<value_type>(_obj) <= _v);
+          return (static_cast<value_type>(_obj) != _v);
         },
         py::is_operator());
+
+    // Only bind ordering operators for non-complex types
+    if constexpr (!is_complex<value_type>::value) {
+      _atomic.def(
+          "__lt__",
+          [](atomic_type &_obj, value_type _v) {
+            return (static_cast<value_type>(_obj) < _v);
+          },
+          py::is_operator());
+      _atomic.def(
+          "__gt__",
+          [](atomic_type &_obj, value_type _v) {
+            return (static_cast<value_type>(_obj) > _v);
+          },
+          py::is_operator());
+      _atomic.def(
+          "__le__",
+          [](atomic_type &_obj, value_type _v) {
+            return (static_cast<value_type>(_obj) <= _v);
+          },
+          py::is_operator());
+      _atomic.def(
+          "__ge__",
+          [](atomic_type &_obj, value_type _v) {
+            return (static_cast<value_type>(_obj) >= _v);
+          },
+          py::is_operator());
+    }
+
+    // self type
+    _atomic.def(py::self + py::self);
+    _atomic.def(py::self - py::self);
+    _atomic.def(py::self += py::self);
     _atomic.def(
-        "__ge__",
-        [](atomic_type &_obj, value_type _v) {
-          return (static_cast<value_type>(_obj) >= _v);
-        },
+        "__isub__",
+        [](atomic_type &lhs, const atomic_type &rhs) { return (lhs -= rhs); },
+        py::is_operator());
+
+    // value type
+    _atomic.def(
+        "__add__", [](atomic_type _obj, value_type _v) { return (_obj += _v); },
+        py::is_operator());
+    _atomic.def(
+        "__sub__", [](atomic_type _obj, value_type _v) { return (_obj -= _v); },
+        py::is_operator());
+    _atomic.def(
+        "__mul__", [](atomic_type _obj, value_type _v) { return (_obj * _v); },
+        py::is_operator());
+    _atomic.def(
+        "__truediv__",
+        [](atomic_type _obj, value_type _v) { return (_obj / _v); },
+        py::is_operator());
+
+    _atomic.def(
+        "__iadd__",
+        [](atomic_type &_obj, value_type _v) { return (_obj += _v); },
+        py::is_operator());
+    _atomic.def(
+        "__isub__",
+        [](atomic_type &_obj, value_type _v) { return (_obj -= _v); },
+        py::is_operator());
+    _atomic.def(
+        "__imul__",
+        [](atomic_type &_obj, value_type _v) { return _obj = (_obj * _v); },
+        py::is_operator());
+    _atomic.def(
+        "__itruediv__",
+        [](atomic_type &_obj, value_type _v) { return _obj = (_obj / _v); },
         py::is_operator());
   }
+};
 
-  // self type
-  _atomic.def(py::self + py::self);
-  _atomic.def(py::self - py::self);
-  _atomic.def(py::self += py::self);
-  _atomic.def(
-      "__isub__",
-      [](atomic_type &lhs, const atomic_type &rhs) { return (lhs -= rhs); },
-      py::is_operator());
-
-  // value type
-  _atomic.def(
-      "__add__", [](atomic_type _obj, value_type _v) { return (_obj += _v); },
-      py::is_operator());
-  _atomic.def(
-      "__sub__", [](atomic_type _obj, value_type _v) { return (_obj -= _v); },
-      py::is_operator());
-  _atomic.def(
-      "__mul__", [](atomic_type _obj, value_type _v) { return (_obj * _v); },
-      py::is_operator());
-  _atomic.def(
-      "__truediv__",
-      [](atomic_type _obj, value_type _v) { return (_obj / _v); },
-      py::is_operator());
-
-  _atomic.def(
-      "__iadd__", [](atomic_type &_obj, value_type _v) { return (_obj += _v); },
-      py::is_operator());
-  _atomic.def(
-      "__isub__", [](atomic_type &_obj, value_type _v) { return (_obj -= _v); },
-      py::is_operator());
-  _atomic.def(
-      "__imul__",
-      [](atomic_type &_obj, value_type _v) { return _obj = (_obj * _v); },
-      py::is_operator());
-  _atomic.def(
-      "__itruediv__",
-      [](atomic_type &_obj, value_type _v) { return _obj = (_obj / _v); },
-      py::is_operator());
+template <size_t DataIdx, size_t SpaceIdx, size_t DimIdx, size_t LayoutIdx>
+void generate_atomic_variant(py::module &_mod) {
+  generate_pyclass<atomic_variant<DataIdx, SpaceIdx, DimIdx, LayoutIdx>>(_mod);
 }
 }  // namespace SpaceDim
 
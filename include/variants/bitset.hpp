@@ -0,0 +1,268 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include <Kokkos_Bitset.hpp>
+#include <iostream>
+#include <string>
+
+#include "common.hpp"
+#include "concepts.hpp"
+#include "traits.hpp"
+#include "views.hpp"
+
+//----------------------------------------------------------------------------//
+//
+//                            Kokkos::Bitset bindings
+//
+//----------------------------------------------------------------------------//
+
+namespace Impl {
+struct bitset_set_tag {};
+struct bitset_reset_tag {};
+struct bitset_test_tag {};
+struct bitset_to_mask_tag {};
+struct bitset_from_mask_tag {};
+
+// the bulk operations on the bits given by the indices (or every bit for the
+// mask conversions)
+template <typename BitsetT, typename IndexT, typename MaskT>
+struct bitset_functor {
+  KOKKOS_INLINE_FUNCTION
+  void operator()(bitset_set_tag, const size_t i) const {
+    m_bitset.set(m_indices(i));
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(bitset_reset_tag, const size_t i) const {
+    m_bitset.reset(m_indices(i));
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(bitset_test_tag, const size_t i) const {
+    m_mask(i) = (m_bitset.test(m_indices(i))) ? 1 : 0;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(bitset_to_mask_tag, const size_t i) const {
+    m_mask(i) = (m_bitset.test(i)) ? 1 : 0;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(bitset_from_mask_tag, const size_t i) const {
+    if (m_mask(i) != 0)
+      m_bitset.set(i);
+    else
+      m_bitset.reset(i);
+  }
+
+  BitsetT m_bitset;
+  IndexT m_indices;
+  MaskT m_mask;
+};
+}  // namespace Impl
+
+namespace Space {
+namespace SpaceDim {
+
+// the types and the python class name for a Kokkos::Bitset in the given
+// memory space
+template <size_t SpaceIdx>
+struct bitset_variant {
+  using space_spec_t = MemorySpaceSpecialization<SpaceIdx>;
+  using Sp           = typename space_spec_t::type;
+  using exec_t       = typename Sp::execution_space;
+  using device_t     = Kokkos::Device<exec_t, Sp>;
+  using type         = Kokkos::Bitset<device_t>;
+  using mask_view_t  = kokkos_python_view_1d_t<uint8_t, Sp>;
+  using flat_mask_t  = Impl::flat_view_t<uint8_t, Sp>;
+
+  static std::string name() {
+    return join("_", "KokkosBitset", space_spec_t::label());
+  }
+
+  template <typename TagT, typename IndexT>
+  static void launch(const char *_label, type &_bitset, size_t _n,
+                     const IndexT &_indices, const flat_mask_t &_mask) {
+    using functor_t = Impl::bitset_functor<type, IndexT, flat_mask_t>;
+    py::gil_scoped_release _nogil{};
+    Kokkos::parallel_for(_label, Kokkos::RangePolicy<exec_t, TagT>(0, _n),
+                         functor_t{_bitset, _indices, _mask});
+    exec_t{}.fence();
+  }
+
+  template <typename Kp>
+  static void generate_bulk(py::class_<type> &_bitset) {
+    using index_view_t = kokkos_python_view_1d_t<Kp, Sp>;
+
+    _bitset.def(
+        "set",
+        [](type &_b, const index_view_t &_idx) {
+          launch<Impl::bitset_set_tag>("pykokkos_bitset_set", _b,
+                                       _idx.extent(0),
+                                       Impl::get_flat_view(_idx),
+                                       flat_mask_t{});
+        },
+        "Set the bits at the indices in parallel", py::arg("indices"));
+    _bitset.def(
+        "reset",
+        [](type &_b, const index_view_t &_idx) {
+          launch<Impl::bitset_reset_tag>("pykokkos_bitset_reset", _b,
+                                         _idx.extent(0),
+                                         Impl::get_flat_view(_idx),
+                                         flat_mask_t{});
+        },
+        "Reset the bits at the indices in parallel", py::arg("indices"));
+    _bitset.def(
+        "test",
+        [](type &_b, const index_view_t &_idx) {
+          auto _mask = mask_view_t{"mask", _idx.extent(0)};
+          launch<Impl::bitset_test_tag>("pykokkos_bitset_test", _b,
+                                        _idx.extent(0),
+                                        Impl::get_flat_view(_idx),
+                                        Impl::get_flat_view(_mask));
+          return _mask;
+        },
+        "Test the bits at the indices in parallel. Returns a uint8 view "
+        "which is 1 where the bit is set",
+        py::arg("indices"));
+  }
+
+  static void generate(py::module &_mod) {
+    if (!add_pyclass<type>()) return;
+
+    auto _name = name();
+    if (debug_output())
+      std::cerr << "Registering " << demangle<type>() << " as python class '"
+                << _name << "'..." << std::endl;
+
+    ensure_pyclass<mask_view_t>(_mod);
+
+    py::class_<type> _bitset(_mod, _name.c_str());
+
+    _bitset.def(py::init([](unsigned _size) { return new type{_size}; }),
+                "All the bits are reset", py::arg("size"));
+
+    _bitset.def(
+        "size", [](type &_b) { return _b.size(); }, "Number of bits");
+    _bitset.def(
+        "__len__", [](type &_b) { return _b.size(); }, "Number of bits");
+    _bitset.def(
+        "count",
+        [](type &_b) {
+          py::gil_scoped_release _nogil{};
+          return _b.count();
+        },
+        "Number of set bits");
+    _bitset.def(
+        "set",
+        [](type &_b) {
+          py::gil_scoped_release _nogil{};
+          _b.set();
+        },
+        "Set every bit");
+    _bitset.def(
+        "reset",
+        [](type &_b) {
+          py::gil_scoped_release _nogil{};
+          _b.reset();
+        },
+        "Reset every bit");
+
+    generate_bulk<int32_t>(_bitset);
+    generate_bulk<int64_t>(_bitset);
+
+    _bitset.def(
+        "to_mask",
+        [](type &_b) {
+          auto _mask = mask_view_t{"mask", _b.size()};
+          launch<Impl::bitset_to_mask_tag>(
+              "pykokkos_bitset_to_mask", _b, _b.size(),
+              Impl::flat_view_t<int32_t, Sp>{}, Impl::get_flat_view(_mask));
+          return _mask;
+        },
+        "Convert to a uint8 view with one element per bit");
+    _bitset.def(
+        "from_mask",
+        [](type &_b, const mask_view_t &_mask) {
+          if (_mask.extent(0) != _b.size())
+            throw py::value_error(
+                "Error! The mask and the bitset have different sizes");
+          launch<Impl::bitset_from_mask_tag>(
+              "pykokkos_bitset_from_mask", _b, _b.size(),
+              Impl::flat_view_t<int32_t, Sp>{}, Impl::get_flat_view(_mask));
+        },
+        "Set the bits where the uint8 view is non-zero and reset the others",
+        py::arg("mask"));
+
+    _bitset.def_property_readonly(
+        "space", [](type &) { return MemorySpaceIndex<Sp>::value; },
+        "Memory space of the bitset");
+  }
+};
+
+template <size_t SpaceIdx>
+void generate_bitset_variant(
+    py::module &,
+    std::enable_if_t<!is_available<memory_space_t<SpaceIdx>>::value, int> = 0) {
+}
+
+template <size_t SpaceIdx>
+void generate_bitset_variant(
+    py::module &_mod,
+    std::enable_if_t<is_available<memory_space_t<SpaceIdx>>::value, int> = 0) {
+  generate_pyclass<bitset_variant<SpaceIdx>>(_mod);
+}
+}  // namespace SpaceDim
+}  // namespace Space
+
+namespace {
+// generate a bitset for each memory space
+template <size_t... SpaceIdx>
+void generate_bitset_variant(py::module &_mod,
+                             std::index_sequence<SpaceIdx...>) {
+  FOLD_EXPRESSION(Space::SpaceDim::generate_bitset_variant<SpaceIdx>(_mod));
+}
+}  // namespace
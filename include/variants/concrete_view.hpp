@@ -47,15 +47,17 @@
 #include "common.hpp"
 #include "concepts.hpp"
 #include "traits.hpp"
+#include "view_factory.hpp"
 #include "views.hpp"
 
 namespace Space {
 namespace SpaceDim {
 
-// this generates a binding for a fixed rank view (i.e. Kokkos::View<...>)
+// the types and the python class name for a fixed rank view (i.e.
+// Kokkos::View<...>) or, when MirrorV is true, for its host mirror
 template <size_t DataIdx, size_t SpaceIdx, size_t DimIdx, size_t LayoutIdx,
-          size_t TraitIdx>
-void generate_concrete_view_variant(py::module &_mod) {
+          size_t TraitIdx, bool MirrorV = false>
+struct concrete_view_variant {
   using data_spec_t   = ViewDataTypeSpecialization<DataIdx>;
   using space_spec_t  = MemorySpaceSpecialization<SpaceIdx>;
   using layout_spec_t = MemoryLayoutSpecialization<LayoutIdx>;
@@ -67,23 +69,54 @@ void generate_concrete_view_variant(py::module &_mod) {
   using Mp            = typename trait_spec_t::type;
   using ViewT         = view_type_t<Kokkos::View<Vp>, Lp, Sp, Mp>;
   using UniformT      = kokkos_python_view_type_t<ViewT>;
+  using MirrorT       = kokkos_python_view_type_t<typename ViewT::HostMirror>;
+  using type          = std::conditional_t<MirrorV, MirrorT, UniformT>;
+
+  static constexpr size_t data_idx     = DataIdx;
+  static constexpr size_t space_idx    = SpaceIdx;
+  static constexpr size_t layout_idx   = LayoutIdx;
+  static constexpr size_t trait_idx    = TraitIdx;
+  static constexpr bool explicit_trait = !is_implicit<Mp>::value;
 
-  constexpr bool explicit_trait = !is_implicit<Mp>::value;
+  static std::string name() {
+    auto _name = join("_", "KokkosView", data_spec_t::label(),
+                      space_spec_t::label(), layout_spec_t::label(),
+                      (explicit_trait) ? trait_spec_t::label() : std::string{},
+                      DimIdx + 1);
+    return (MirrorV) ? _name + "_mirror" : _name;
+  }
+
+  // same as the default label of kokkos.array
+  static std::string default_label() {
+    return "KokkosView<" +
+           join(", ", data_spec_t::label() + std::string(DimIdx + 1, '*'),
+                layout_spec_t::label(), space_spec_t::label(),
+                (explicit_trait) ? trait_spec_t::label() : std::string{}) +
+           ">";
+  }
 
-  auto name = join("_", "KokkosView", data_spec_t::label(),
-                   space_spec_t::label(), layout_spec_t::label(),
-                   (explicit_trait) ? trait_spec_t::label() : std::string{},
-                   DimIdx + 1);
+  static void generate(py::module &_mod) {
+    Common::generate_view<type, Sp, Tp, Lp, Mp, DimIdx, DimIdx>(_mod, name());
+  }
+};
+
+// this generates a binding for a fixed rank view (i.e. Kokkos::View<...>)
+template <size_t DataIdx, size_t SpaceIdx, size_t DimIdx, size_t LayoutIdx,
+          size_t TraitIdx>
+void generate_concrete_view_variant(py::module &_mod) {
+  using variant_t =
+      concrete_view_variant<DataIdx, SpaceIdx, DimIdx, LayoutIdx, TraitIdx>;
 
-  Common::generate_view<UniformT, Sp, Tp, Lp, Mp, DimIdx, DimIdx>(
-      _mod, name, demangle<UniformT>());
+  generate_pyclass<variant_t>(_mod);
+  view_factory::add<variant_t, DimIdx>(std::index_sequence<DimIdx>{});
 
 #if !defined(ENABLE_LAYOUTS)
-  using MirrorT = kokkos_python_view_type_t<typename ViewT::HostMirror>;
+  using mirror_t = concrete_view_variant<DataIdx, SpaceIdx, DimIdx, LayoutIdx,
+                                         TraitIdx, true>;
 
-  IF_CONSTEXPR(!std::is_same<UniformT, MirrorT>::value) {
-    Common::generate_view<MirrorT, Sp, Tp, Lp, Mp, DimIdx, DimIdx>(
-        _mod, name + "_mirror", demangle<MirrorT>());
+  IF_CONSTEXPR(!std::is_same<typename variant_t::type,
+                             typename mirror_t::type>::value) {
+    generate_pyclass<mirror_t>(_mod);
   }
 #endif
 }
@@ -0,0 +1,444 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include <Kokkos_StaticCrsGraph.hpp>
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include "common.hpp"
+#include "concepts.hpp"
+#include "traits.hpp"
+#include "views.hpp"
+
+//----------------------------------------------------------------------------//
+//
+//            compressed sparse row matrix on Kokkos::StaticCrsGraph
+//
+//----------------------------------------------------------------------------//
+
+namespace Impl {
+// the sparsity pattern is a StaticCrsGraph which shares the allocations of
+// the row map and the entries views, the values view holds the non-zeros
+template <typename Tp, typename Kp, typename Sp>
+struct crs_matrix {
+  using exec_t   = typename Sp::execution_space;
+  using device_t = Kokkos::Device<exec_t, Sp>;
+  using graph_type =
+      Kokkos::StaticCrsGraph<Kp, Kokkos::LayoutRight, device_t, void, Kp>;
+  using index_view_t = kokkos_python_view_1d_t<Kp, Sp>;
+  using value_view_t = kokkos_python_view_1d_t<Tp, Sp>;
+
+  crs_matrix(const index_view_t &_row_map, const index_view_t &_entries,
+             const value_view_t &_values, size_t _num_cols)
+      : m_row_map{_row_map},
+        m_entries{_entries},
+        m_values{_values},
+        m_graph{_entries, _row_map},
+        m_num_cols{_num_cols} {}
+
+  size_t num_rows() const { return m_graph.numRows(); }
+  size_t num_cols() const { return m_num_cols; }
+  size_t nnz() const { return m_entries.extent(0); }
+
+  index_view_t m_row_map;
+  index_view_t m_entries;
+  value_view_t m_values;
+  graph_type m_graph;
+  size_t m_num_cols = 0;
+};
+
+struct crs_spmv_tag {};
+struct crs_spmv_transpose_tag {};
+struct crs_scale_tag {};
+struct crs_row_map_tag {};
+struct crs_entries_tag {};
+
+// counts the decreasing row map offsets and the column indices outside of
+// [0, num_cols) so that spmv never reads or writes out of bounds
+template <typename ViewT>
+struct crs_validate_functor {
+  using ordinal_t = typename ViewT::non_const_value_type;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(crs_row_map_tag, const size_t i, size_t &_invalid) const {
+    if (m_view(i + 1) < m_view(i)) ++_invalid;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(crs_entries_tag, const size_t i, size_t &_invalid) const {
+    const ordinal_t _col = m_view(i);
+    if (_col < 0 || static_cast<size_t>(_col) >= m_num_cols) ++_invalid;
+  }
+
+  ViewT m_view;
+  size_t m_num_cols;
+};
+
+// y = alpha * A * x + beta * y with a team per block of rows, a thread per
+// row, and the vector lanes reducing over the non-zeros of the row. The
+// transpose scatters alpha * A(row, col) * x(row) into y(col) atomically
+// after y has been scaled by beta
+template <typename GraphT, typename ValuesT, typename ViewT>
+struct crs_spmv_functor {
+  using graph_type  = GraphT;
+  using value_type  = typename ValuesT::non_const_value_type;
+  using ordinal_t   = typename graph_type::data_type;
+  using size_type   = typename graph_type::size_type;
+  using exec_t      = typename graph_type::execution_space;
+  using member_type = typename Kokkos::TeamPolicy<exec_t>::member_type;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(crs_spmv_tag, const member_type &_team) const {
+    const ordinal_t _begin = _team.league_rank() * m_rows_per_team;
+    const ordinal_t _end   = Kokkos::min(_begin + m_rows_per_team, m_num_rows);
+    const auto _rows       = Kokkos::TeamThreadRange(_team, _begin, _end);
+    Kokkos::parallel_for(_rows, [&](const ordinal_t _row) {
+      value_type _sum = 0;
+      Kokkos::parallel_reduce(
+          Kokkos::ThreadVectorRange(_team, m_graph.row_map(_row),
+                                    m_graph.row_map(_row + 1)),
+          [&](const size_type _k, value_type &_lsum) {
+            _lsum += m_values(_k) * m_x(m_graph.entries(_k));
+          },
+          _sum);
+      // beta == 0 overwrites y so that it does not need to be initialized
+      Kokkos::single(Kokkos::PerThread(_team), [&]() {
+        m_y(_row) = (m_beta == value_type{0})
+                        ? m_alpha * _sum
+                        : m_alpha * _sum + m_beta * m_y(_row);
+      });
+    });
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(crs_spmv_transpose_tag, const member_type &_team) const {
+    const ordinal_t _begin = _team.league_rank() * m_rows_per_team;
+    const ordinal_t _end   = Kokkos::min(_begin + m_rows_per_team, m_num_rows);
+    const auto _rows       = Kokkos::TeamThreadRange(_team, _begin, _end);
+    Kokkos::parallel_for(_rows, [&](const ordinal_t _row) {
+      const value_type _x = m_alpha * m_x(_row);
+      Kokkos::parallel_for(
+          Kokkos::ThreadVectorRange(_team, m_graph.row_map(_row),
+                                    m_graph.row_map(_row + 1)),
+          [&](const size_type _k) {
+            Kokkos::atomic_add(&m_y(m_graph.entries(_k)), m_values(_k) * _x);
+          });
+    });
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(crs_scale_tag, const size_t i) const {
+    m_y(i) = (m_beta == value_type{0}) ? value_type{0} : m_beta * m_y(i);
+  }
+
+  graph_type m_graph;
+  ValuesT m_values;
+  ViewT m_x;
+  ViewT m_y;
+  value_type m_alpha;
+  value_type m_beta;
+  ordinal_t m_num_rows;
+  ordinal_t m_rows_per_team;
+};
+}  // namespace Impl
+
+namespace Space {
+namespace SpaceDim {
+
+// the types and the python class name for a CSR matrix with the given value
+// and ordinal (column index and row offset) types
+template <size_t DataIdx, size_t OrdinalIdx, size_t SpaceIdx>
+struct crs_matrix_variant {
+  using data_spec_t    = ViewDataTypeSpecialization<DataIdx>;
+  using ordinal_spec_t = ViewDataTypeSpecialization<OrdinalIdx>;
+  using space_spec_t   = MemorySpaceSpecialization<SpaceIdx>;
+  using Tp             = typename data_spec_t::type;
+  using Kp             = typename ordinal_spec_t::type;
+  using Sp             = typename space_spec_t::type;
+  using exec_t         = typename Sp::execution_space;
+  using type           = Impl::crs_matrix<Tp, Kp, Sp>;
+  using index_view_t   = typename type::index_view_t;
+  using value_view_t   = typename type::value_view_t;
+  using flat_view_t    = Impl::flat_view_t<Tp, Sp>;
+  using functor_t =
+      Impl::crs_spmv_functor<typename type::graph_type, flat_view_t,
+                             flat_view_t>;
+
+  // rows per thread for host execution spaces and the maximum vector length
+  // for non-host execution spaces
+  static constexpr Kp host_rows_per_thread = 64;
+  static constexpr int max_vector_length   = 32;
+
+  static std::string name() {
+    return join("_", "KokkosCrsMatrix", data_spec_t::label(),
+                ordinal_spec_t::label(), space_spec_t::label());
+  }
+
+  // the number of decreasing row map offsets and of out of range entries
+  static std::pair<size_t, size_t> validate(const index_view_t &_row_map,
+                                            const index_view_t &_entries,
+                                            size_t _num_cols) {
+    using validate_t = Impl::crs_validate_functor<Impl::flat_view_t<Kp, Sp>>;
+    auto _invalid    = std::pair<size_t, size_t>{0, 0};
+
+    py::gil_scoped_release _nogil{};
+    Kokkos::parallel_reduce(
+        "pykokkos_crs_matrix_validate_row_map",
+        Kokkos::RangePolicy<exec_t, Impl::crs_row_map_tag>(
+            0, _row_map.extent(0) - 1),
+        validate_t{Impl::get_flat_view(_row_map), _num_cols}, _invalid.first);
+    Kokkos::parallel_reduce(
+        "pykokkos_crs_matrix_validate_entries",
+        Kokkos::RangePolicy<exec_t, Impl::crs_entries_tag>(
+            0, _entries.extent(0)),
+        validate_t{Impl::get_flat_view(_entries), _num_cols}, _invalid.second);
+    return _invalid;
+  }
+
+  static void spmv(type &_a, const value_view_t &_x, value_view_t &_y,
+                   Tp _alpha, Tp _beta, bool _transpose) {
+    auto _nrows = _a.num_rows();
+    auto _ncols = _a.num_cols();
+    if (_x.extent(0) != ((_transpose) ? _nrows : _ncols) ||
+        _y.extent(0) != ((_transpose) ? _ncols : _nrows))
+      throw py::value_error(
+          "Error! The extents of x and y do not match the matrix");
+    if (_x.data() == _y.data())
+      throw py::value_error("Error! x and y must not be the same view");
+
+    // the vector lanes reduce over the non-zeros of a row so the vector
+    // length follows the average number of non-zeros per row
+    int _vector_length = 1;
+    if constexpr (!Kokkos::SpaceAccessibility<exec_t,
+                                              Kokkos::HostSpace>::accessible) {
+      auto _avg = (_nrows > 0) ? _a.nnz() / _nrows : 0;
+      while (_vector_length < max_vector_length &&
+             static_cast<size_t>(2 * _vector_length) <= _avg)
+        _vector_length *= 2;
+    }
+
+    auto _functor =
+        functor_t{_a.m_graph, Impl::get_flat_view(_a.m_values),
+                  Impl::get_flat_view(_x), Impl::get_flat_view(_y), _alpha,
+                  _beta, static_cast<Kp>(_nrows), host_rows_per_thread};
+
+    // like KokkosKernels, every thread of a team of the recommended size
+    // handles a row on non-host execution spaces and a team of a single
+    // thread handles a block of rows on host execution spaces
+    auto _launch = [&](auto _tag, const char *_label) {
+      using policy_t = Kokkos::TeamPolicy<exec_t, decltype(_tag)>;
+
+      int _team_size      = 1;
+      Kp _rows_per_thread = host_rows_per_thread;
+      if constexpr (!Kokkos::SpaceAccessibility<
+                        exec_t, Kokkos::HostSpace>::accessible) {
+        _team_size = policy_t{1, 1, _vector_length}.team_size_recommended(
+            _functor, Kokkos::ParallelForTag{});
+        _rows_per_thread = 1;
+      }
+      _functor.m_rows_per_team = static_cast<Kp>(_team_size) * _rows_per_thread;
+      auto _rows_per_team      = static_cast<size_t>(_functor.m_rows_per_team);
+      auto _league =
+          static_cast<int>((_nrows + _rows_per_team - 1) / _rows_per_team);
+      Kokkos::parallel_for(_label,
+                           policy_t(_league, _team_size, _vector_length),
+                           _functor);
+    };
+
+    py::gil_scoped_release _nogil{};
+    if (_transpose) {
+      Kokkos::parallel_for(
+          "pykokkos_crs_matrix_scale",
+          Kokkos::RangePolicy<exec_t, Impl::crs_scale_tag>(0, _ncols),
+          _functor);
+      _launch(Impl::crs_spmv_transpose_tag{},
+              "pykokkos_crs_matrix_spmv_transpose");
+    } else {
+      _launch(Impl::crs_spmv_tag{}, "pykokkos_crs_matrix_spmv");
+    }
+    exec_t{}.fence();
+  }
+
+  static void generate(py::module &_mod) {
+    if (!add_pyclass<type>()) return;
+
+    auto _name = name();
+    if (debug_output())
+      std::cerr << "Registering " << demangle<type>() << " as python class '"
+                << _name << "'..." << std::endl;
+
+    ensure_pyclass<index_view_t>(_mod);
+    ensure_pyclass<value_view_t>(_mod);
+
+    py::class_<type> _matrix(_mod, _name.c_str());
+
+    _matrix.def(
+        py::init([](const index_view_t &_row_map, const index_view_t &_entries,
+                    const value_view_t &_values, size_t _num_cols) {
+          if (_row_map.extent(0) == 0)
+            throw py::value_error(
+                "Error! The row map needs an extent of at least one");
+          if (_entries.extent(0) != _values.extent(0))
+            throw py::value_error(
+                "Error! The entries and the values have different extents");
+          // the first offset is zero and the last offset is the number of
+          // non-zeros
+          Kp _first = 0;
+          Kp _nnz   = 0;
+          Kokkos::deep_copy(_first, Kokkos::subview(_row_map, 0));
+          Kokkos::deep_copy(
+              _nnz, Kokkos::subview(_row_map, _row_map.extent(0) - 1));
+          if (_first != 0)
+            throw py::value_error("Error! The first row map offset is " +
+                                  std::to_string(_first) + " instead of 0");
+          if (static_cast<size_t>(_nnz) != _entries.extent(0))
+            throw py::value_error("Error! The last row map offset is " +
+                                  std::to_string(_nnz) + " but there are " +
+                                  std::to_string(_entries.extent(0)) +
+                                  " entries");
+          auto _invalid = validate(_row_map, _entries, _num_cols);
+          if (_invalid.first > 0)
+            throw py::value_error("Error! The row map offsets decrease " +
+                                  std::to_string(_invalid.first) + " times");
+          if (_invalid.second > 0)
+            throw py::value_error("Error! " + std::to_string(_invalid.second) +
+                                  " entries are outside of [0, " +
+                                  std::to_string(_num_cols) + ")");
+          return new type{_row_map, _entries, _values, _num_cols};
+        }),
+        "The matrix shares the allocations of the row map (num_rows + 1 "
+        "offsets), the entries (column indices), and the values",
+        py::arg("row_map"), py::arg("entries"), py::arg("values"),
+        py::arg("num_cols"), py::keep_alive<1, 2>(), py::keep_alive<1, 3>(),
+        py::keep_alive<1, 4>());
+
+    _matrix.def("spmv", &spmv,
+                "y = alpha * A * x + beta * y, or with the transpose of A",
+                py::arg("x"), py::arg("y"), py::arg("alpha") = Tp{1},
+                py::arg("beta") = Tp{0}, py::arg("transpose") = false);
+    _matrix.def(
+        "__matmul__",
+        [](type &_a, const value_view_t &_x) {
+          auto _y = value_view_t{"y", _a.num_rows()};
+          spmv(_a, _x, _y, Tp{1}, Tp{0}, false);
+          return _y;
+        },
+        "Returns A * x as a new view", py::arg("x"));
+
+    _matrix.def_property_readonly(
+        "num_rows", [](type &_a) { return _a.num_rows(); }, "Number of rows");
+    _matrix.def_property_readonly(
+        "num_cols", [](type &_a) { return _a.num_cols(); },
+        "Number of columns");
+    _matrix.def_property_readonly(
+        "nnz", [](type &_a) { return _a.nnz(); }, "Number of non-zeros");
+    _matrix.def_property_readonly(
+        "shape",
+        [](type &_a) {
+          return std::array<size_t, 2>{_a.num_rows(), _a.num_cols()};
+        },
+        "Number of rows and columns");
+    // the returned views keep the matrix (and thus the views it was
+    // constructed from) alive
+    _matrix.def_property_readonly(
+        "row_map",
+        py::cpp_function([](type &_a) { return _a.m_row_map; },
+                         py::keep_alive<0, 1>()),
+        "Offset of the first non-zero of each row");
+    _matrix.def_property_readonly(
+        "entries",
+        py::cpp_function([](type &_a) { return _a.m_entries; },
+                         py::keep_alive<0, 1>()),
+        "Column index of each non-zero");
+    _matrix.def_property_readonly(
+        "values",
+        py::cpp_function([](type &_a) { return _a.m_values; },
+                         py::keep_alive<0, 1>()),
+        "Value of each non-zero");
+    _matrix.def_property_readonly(
+        "dtype", [](type &) { return ViewDataTypeIndex<Tp>::value; },
+        "Data type of the values");
+    _matrix.def_property_readonly(
+        "space", [](type &) { return MemorySpaceIndex<Sp>::value; },
+        "Memory space of the matrix");
+  }
+};
+
+template <size_t DataIdx, size_t OrdinalIdx, size_t SpaceIdx>
+void generate_crs_matrix_variant(
+    py::module &,
+    std::enable_if_t<!is_available<memory_space_t<SpaceIdx>>::value, int> = 0) {
+}
+
+template <size_t DataIdx, size_t OrdinalIdx, size_t SpaceIdx>
+void generate_crs_matrix_variant(
+    py::module &_mod,
+    std::enable_if_t<is_available<memory_space_t<SpaceIdx>>::value, int> = 0) {
+  generate_pyclass<crs_matrix_variant<DataIdx, OrdinalIdx, SpaceIdx>>(_mod);
+}
+}  // namespace SpaceDim
+
+// expand for every memory space
+template <size_t DataIdx, size_t OrdinalIdx, size_t... SpaceIdx>
+void generate_crs_matrix_variant(py::module &_mod,
+                                 std::index_sequence<SpaceIdx...>) {
+  FOLD_EXPRESSION(
+      SpaceDim::generate_crs_matrix_variant<DataIdx, OrdinalIdx, SpaceIdx>(
+          _mod));
+}
+}  // namespace Space
+
+namespace {
+// generate the matrices for a value type with every ordinal type
+template <size_t DataIdx, size_t... OrdinalIdx>
+void generate_crs_matrix_variant(py::module &_mod,
+                                 std::index_sequence<OrdinalIdx...>) {
+  FOLD_EXPRESSION(Space::generate_crs_matrix_variant<DataIdx, OrdinalIdx>(
+      _mod, std::make_index_sequence<MemorySpacesEnd>{}));
+}
+}  // namespace
@@ -0,0 +1,214 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include <Kokkos_DualView.hpp>
+#include <array>
+#include <iostream>
+#include <string>
+
+#include "common.hpp"
+#include "concepts.hpp"
+#include "traits.hpp"
+#include "views.hpp"
+
+namespace Space {
+namespace SpaceDim {
+
+// the types and the python class name for a Kokkos::DualView whose device
+// view is the fixed rank view in the given memory space
+template <size_t DataIdx, size_t SpaceIdx, size_t DimIdx, size_t LayoutIdx>
+struct dual_view_variant {
+  using data_spec_t   = ViewDataTypeSpecialization<DataIdx>;
+  using space_spec_t  = MemorySpaceSpecialization<SpaceIdx>;
+  using layout_spec_t = MemoryLayoutSpecialization<LayoutIdx>;
+  using Tp            = typename data_spec_t::type;
+  using Vp            = typename ViewDataTypeRepr<Tp, DimIdx>::type;
+  using Sp            = typename space_spec_t::type;
+  using Lp            = typename layout_spec_t::type;
+  using type          = Kokkos::DualView<Vp, Lp, Sp>;
+  using device_view_t = kokkos_python_view_type_t<typename type::t_dev>;
+  using host_view_t   = kokkos_python_view_type_t<typename type::t_host>;
+
+  static std::string name() {
+    return join("_", "KokkosDualView", data_spec_t::label(),
+                space_spec_t::label(), layout_spec_t::label(), DimIdx + 1);
+  }
+
+  static void generate(py::module &_mod) {
+    if (!add_pyclass<type>()) return;
+
+    auto _name = name();
+    if (debug_output())
+      std::cerr << "Registering " << demangle<type>() << " as python class '"
+                << _name << "'..." << std::endl;
+
+    // view_host and view_device return the generated view classes
+    ensure_pyclass<device_view_t>(_mod);
+    ensure_pyclass<host_view_t>(_mod);
+
+    py::class_<type> _dual(_mod, _name.c_str());
+
+    _dual.def(py::init([](std::string _label,
+                          std::array<size_t, DimIdx + 1> _shape) {
+                return Impl::construct_from_extents<type>(
+                    _label, _shape, std::make_index_sequence<DimIdx + 1>{});
+              }),
+              py::arg("label"), py::arg("shape"));
+
+    _dual.def(
+        "modify_host", [](type &_v) { _v.modify_host(); },
+        "Mark the host view as modified");
+    _dual.def(
+        "modify_device", [](type &_v) { _v.modify_device(); },
+        "Mark the device view as modified");
+    _dual.def(
+        "clear_sync_state", [](type &_v) { _v.clear_sync_state(); },
+        "Mark both views as up to date");
+
+    _dual.def(
+        "sync_host", [](type &_v) { _v.sync_host(); },
+        "Copy the device view to the host view if the device view was "
+        "modified");
+    _dual.def(
+        "sync_device", [](type &_v) { _v.sync_device(); },
+        "Copy the host view to the device view if the host view was "
+        "modified");
+    _dual.def(
+        "need_sync_host", [](type &_v) { return _v.need_sync_host(); },
+        "Whether the device view was modified since the last sync");
+    _dual.def(
+        "need_sync_device", [](type &_v) { return _v.need_sync_device(); },
+        "Whether the host view was modified since the last sync");
+
+    // the accessors sync before returning the view (a no-op when the view
+    // is up to date) and optionally mark it as modified so that the sync
+    // state follows the python-side usage
+    _dual.def(
+        "view_host",
+        [](type &_v, bool _sync, bool _modify) {
+          if (_sync) _v.sync_host();
+          if (_modify) _v.modify_host();
+          return static_cast<host_view_t>(_v.view_host());
+        },
+        "Get the host view", py::arg("sync") = true,
+        py::arg("modify") = false);
+    _dual.def(
+        "view_device",
+        [](type &_v, bool _sync, bool _modify) {
+          if (_sync) _v.sync_device();
+          if (_modify) _v.modify_device();
+          return static_cast<device_view_t>(_v.view_device());
+        },
+        "Get the device view", py::arg("sync") = true,
+        py::arg("modify") = false);
+
+    _dual.def_property_readonly(
+        "shape",
+        [](type &_v) {
+          return get_extents(_v.view_device(),
+                             std::make_index_sequence<DimIdx + 1>{});
+        },
+        "Get the shape of the views (extents)");
+    _dual.def_property_readonly(
+        "label", [](type &_v) { return _v.view_device().label(); },
+        "Label of the views");
+    _dual.def_property_readonly(
+        "dtype", [](type &) { return ViewDataTypeIndex<Tp>::value; },
+        "Data type of the views");
+    _dual.def_property_readonly(
+        "space", [](type &) { return MemorySpaceIndex<Sp>::value; },
+        "Memory space of the device view");
+    _dual.def_property_readonly(
+        "layout", [](type &) { return MemoryLayoutIndex<Lp>::value; },
+        "Memory layout of the views");
+  }
+};
+
+template <size_t DataIdx, size_t SpaceIdx, size_t DimIdx, size_t LayoutIdx>
+void generate_dual_view_variant(py::module &_mod) {
+  generate_pyclass<dual_view_variant<DataIdx, SpaceIdx, DimIdx, LayoutIdx>>(
+      _mod);
+}
+}  // namespace SpaceDim
+
+// if the space is not available do nothing
+template <size_t LayoutIdx, size_t DataIdx, size_t SpaceIdx, size_t... DimIdx>
+void generate_dual_view_variant(
+    py::module &, std::index_sequence<DimIdx...>,
+    std::enable_if_t<!is_available<memory_space_t<SpaceIdx>>::value, int> = 0) {
+}
+
+// if the space is available expand for every dimension
+template <size_t LayoutIdx, size_t DataIdx, size_t SpaceIdx, size_t... DimIdx>
+void generate_dual_view_variant(
+    py::module &_mod, std::index_sequence<DimIdx...>,
+    std::enable_if_t<is_available<memory_space_t<SpaceIdx>>::value, int> = 0) {
+  FOLD_EXPRESSION(
+      SpaceDim::generate_dual_view_variant<DataIdx, SpaceIdx, DimIdx,
+                                           LayoutIdx>(_mod));
+}
+}  // namespace Space
+
+namespace variants {
+// expand for all the spaces with a given layout and data-type
+template <size_t LayoutIdx, size_t DataIdx, size_t... SpaceIdx>
+void generate_dual_view_variant(py::module &_mod,
+                                std::index_sequence<SpaceIdx...>) {
+  FOLD_EXPRESSION(
+      Space::generate_dual_view_variant<LayoutIdx, DataIdx, SpaceIdx>(
+          _mod, std::make_index_sequence<ViewDataMaxDimensions>{}));
+}
+}  // namespace variants
+
+namespace {
+// generate data type buffers for each memory space
+template <size_t LayoutIdx, size_t... DataIdx>
+void generate_dual_view_variant(py::module &_mod,
+                                std::index_sequence<DataIdx...>) {
+  FOLD_EXPRESSION(variants::generate_dual_view_variant<LayoutIdx, DataIdx>(
+      _mod, std::make_index_sequence<MemorySpacesEnd>{}));
+}
+}  // namespace
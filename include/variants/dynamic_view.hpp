@@ -45,6 +45,7 @@
 #include "common.hpp"
 #include "concepts.hpp"
 #include "traits.hpp"
+#include "view_factory.hpp"
 #include "views.hpp"
 
 #pragma once
@@ -59,43 +60,80 @@ void generate_dynamic_view_variant(
     std::enable_if_t<!is_available<memory_space_t<SpaceIdx>>::value, int> = 0) {
 }
 
+// the types and the python class name for a dynamic rank view (i.e.
+// Kokkos::DynRankView<...>) or, when MirrorV is true, for its host mirror
+template <size_t DataIdx, size_t SpaceIdx, size_t LayoutIdx, size_t TraitIdx,
+          bool MirrorV = false>
+struct dynamic_view_variant {
+  static constexpr size_t DimIdx = 7;
+
+  using data_spec_t   = ViewDataTypeSpecialization<DataIdx>;
+  using space_spec_t  = MemorySpaceSpecialization<SpaceIdx>;
+  using layout_spec_t = MemoryLayoutSpecialization<LayoutIdx>;
+  using trait_spec_t  = MemoryTraitSpecialization<TraitIdx>;
+  using Tp            = typename data_spec_t::type;
+  using Vp            = Tp;
+  using Sp            = typename space_spec_t::type;
+  using Lp            = typename layout_spec_t::type;
+  using Mp            = typename trait_spec_t::type;
+  using ViewT         = view_type_t<Kokkos::DynRankView<Vp>, Lp, Sp, Mp>;
+  using UniformT      = kokkos_python_view_type_t<ViewT>;
+  using MirrorT =
+      kokkos_python_view_type_t<typename UniformT::HostMirror>;
+  using type = std::conditional_t<MirrorV, MirrorT, UniformT>;
+
+  static constexpr size_t data_idx     = DataIdx;
+  static constexpr size_t space_idx    = SpaceIdx;
+  static constexpr size_t layout_idx   = LayoutIdx;
+  static constexpr size_t trait_idx    = TraitIdx;
+  static constexpr bool explicit_trait = !is_implicit<Mp>::value;
+
+  static std::string name() {
+    auto _name =
+        join("_", "KokkosDynRankView", data_spec_t::label(),
+             space_spec_t::label(), layout_spec_t::label(),
+             (explicit_trait) ? trait_spec_t::label() : std::string{});
+    return (MirrorV) ? _name + "_mirror" : _name;
+  }
+
+  // same as the default label of kokkos.array
+  static std::string default_label() {
+    return "KokkosDynRankView<" +
+           join(", ", data_spec_t::label(), layout_spec_t::label(),
+                space_spec_t::label(),
+                (explicit_trait) ? trait_spec_t::label() : std::string{}) +
+           ">";
+  }
+
+  static void generate(py::module &_mod) {
+    // the Common::generate_view adds 1 so subtract one in order
+    // generate initializers and accessors for all rank dimensions
+    constexpr auto nIdx = DimIdx - 1;
+    Common::generate_view<type, Sp, Tp, Lp, Mp, nIdx>(
+        _mod, name(), DimIdx, std::make_index_sequence<nIdx>{});
+  }
+};
+
 template <size_t DataIdx, size_t SpaceIdx, size_t LayoutIdx, size_t TraitIdx>
 void generate_dynamic_view_variant(
     py::module &_mod,
     std::enable_if_t<is_available<memory_space_t<SpaceIdx>>::value, int> = 0) {
-  constexpr size_t DimIdx = 7;
-  using data_spec_t       = ViewDataTypeSpecialization<DataIdx>;
-  using space_spec_t      = MemorySpaceSpecialization<SpaceIdx>;
-  using layout_spec_t     = MemoryLayoutSpecialization<LayoutIdx>;
-  using trait_spec_t      = MemoryTraitSpecialization<TraitIdx>;
-  using Tp                = typename data_spec_t::type;
-  using Vp                = Tp;
-  using Sp                = typename space_spec_t::type;
-  using Lp                = typename layout_spec_t::type;
-  using Mp                = typename trait_spec_t::type;
-  using ViewT             = view_type_t<Kokkos::DynRankView<Vp>, Lp, Sp, Mp>;
-  using UniformT          = kokkos_python_view_type_t<ViewT>;
-
-  constexpr bool explicit_trait = !is_implicit<Mp>::value;
-
-  auto name = join("_", "KokkosDynRankView", data_spec_t::label(),
-                   space_spec_t::label(), layout_spec_t::label(),
-                   (explicit_trait) ? trait_spec_t::label() : std::string{});
+  using variant_t =
+      dynamic_view_variant<DataIdx, SpaceIdx, LayoutIdx, TraitIdx>;
 
-  // the Common::generate_view adds 1 so subtract one in order
-  // generate initializers and accessors for all rank dimensions
-  constexpr auto nIdx = DimIdx - 1;
-  Common::generate_view<UniformT, Sp, Tp, Lp, Mp, nIdx>(
-      _mod, name, demangle<UniformT>(), DimIdx,
-      std::make_index_sequence<nIdx>{});
+  generate_pyclass<variant_t>(_mod);
+  // the Common::generate_view provides initializers for 1 to DimIdx - 1
+  // extents
+  view_factory::add<variant_t, view_factory::DynamicRankIdx>(
+      std::make_index_sequence<variant_t::DimIdx - 1>{});
 
 #if !defined(ENABLE_LAYOUTS)
-  using MirrorT = kokkos_python_view_type_t<typename UniformT::HostMirror>;
+  using mirror_t =
+      dynamic_view_variant<DataIdx, SpaceIdx, LayoutIdx, TraitIdx, true>;
 
-  IF_CONSTEXPR(!std::is_same<UniformT, MirrorT>::value) {
-    Common::generate_view<MirrorT, Sp, Tp, Lp, Mp, nIdx>(
-        _mod, name + "_mirror", demangle<MirrorT>(), DimIdx,
-        std::make_index_sequence<nIdx>{});
+  IF_CONSTEXPR(!std::is_same<typename variant_t::type,
+                             typename mirror_t::type>::value) {
+    generate_pyclass<mirror_t>(_mod);
   }
 #endif
 }
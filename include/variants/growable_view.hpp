@@ -0,0 +1,314 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include <Kokkos_DynamicView.hpp>
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+#include "common.hpp"
+#include "concepts.hpp"
+#include "traits.hpp"
+#include "views.hpp"
+
+//----------------------------------------------------------------------------//
+//
+//                Kokkos::Experimental::DynamicView bindings
+//
+//----------------------------------------------------------------------------//
+
+namespace Impl {
+// a DynamicView which tracks the number of elements separately from the
+// extent so that the chunks are allocated geometrically and appending is
+// amortized O(1). Growing never moves the existing elements.
+template <typename Tp, typename Sp>
+struct growable_view {
+  using view_type = Kokkos::Experimental::DynamicView<Tp *, Sp>;
+
+  growable_view(const std::string &_label, unsigned _chunk_size,
+                unsigned _max_extent)
+      : m_view{_label, _chunk_size, _max_extent}, m_max_extent{_max_extent} {}
+
+  size_t size() const { return m_size; }
+  size_t capacity() const { return m_capacity; }
+
+  void reserve(size_t _n) {
+    if (_n <= m_capacity) return;
+    if (_n > m_max_extent)
+      throw py::value_error("Error! Size " + std::to_string(_n) +
+                            " exceeds the maximum extent " +
+                            std::to_string(m_max_extent));
+    size_t _chunk = m_view.chunk_size();
+    m_capacity    = std::min<size_t>(
+        std::max<size_t>({_n, 2 * m_capacity, _chunk}), m_max_extent);
+    m_view.resize_serial(m_capacity);
+  }
+
+  void resize(size_t _n) {
+    reserve(_n);
+    m_size = _n;
+  }
+
+  view_type m_view;
+  size_t m_size       = 0;
+  size_t m_capacity   = 0;
+  size_t m_max_extent = 0;
+};
+
+// copies src(i) into dst(offset + i)
+template <typename DstT, typename SrcT>
+struct growable_view_copy_functor {
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t i) const { m_dst(m_offset + i) = m_src(i); }
+
+  DstT m_dst;
+  SrcT m_src;
+  size_t m_offset;
+};
+
+// assigns the value to dst(offset + i)
+template <typename DstT, typename Tp>
+struct growable_view_fill_functor {
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t i) const { m_dst(m_offset + i) = m_value; }
+
+  DstT m_dst;
+  Tp m_value;
+  size_t m_offset;
+};
+}  // namespace Impl
+
+namespace Space {
+namespace SpaceDim {
+
+// the types and the python class name for a growable one-dimensional view
+template <size_t DataIdx, size_t SpaceIdx>
+struct growable_view_variant {
+  using data_spec_t  = ViewDataTypeSpecialization<DataIdx>;
+  using space_spec_t = MemorySpaceSpecialization<SpaceIdx>;
+  using Tp           = typename data_spec_t::type;
+  using Sp           = typename space_spec_t::type;
+  using exec_t       = typename Sp::execution_space;
+  using type         = Impl::growable_view<Tp, Sp>;
+  using dynamic_t    = typename type::view_type;
+  using view_t       = kokkos_python_view_1d_t<Tp, Sp>;
+  using flat_view_t  = Impl::flat_view_t<Tp, Sp>;
+
+  static constexpr bool host_accessible =
+      Kokkos::SpaceAccessibility<Kokkos::HostSpace, Sp>::accessible;
+
+  static std::string name() {
+    return join("_", "KokkosGrowableView", data_spec_t::label(),
+                space_spec_t::label());
+  }
+
+  static void check_index(type &_g, size_t _i) {
+    if (_i >= _g.size())
+      throw py::index_error("Error! Index " + std::to_string(_i) +
+                            " is out of range for size " +
+                            std::to_string(_g.size()));
+  }
+
+  static void generate(py::module &_mod) {
+    if (!add_pyclass<type>()) return;
+
+    auto _name = name();
+    if (debug_output())
+      std::cerr << "Registering " << demangle<dynamic_t>()
+                << " as python class '" << _name << "'..." << std::endl;
+
+    ensure_pyclass<view_t>(_mod);
+
+    py::class_<type> _growable(_mod, _name.c_str());
+
+    _growable.def(py::init([](std::string _label, unsigned _chunk_size,
+                              unsigned _max_extent) {
+                    return new type{_label, _chunk_size, _max_extent};
+                  }),
+                  "The chunk size is rounded up to a power of two and the "
+                  "size can never exceed the maximum extent",
+                  py::arg("label"), py::arg("chunk_size") = 1024,
+                  py::arg("max_extent") = (1u << 28));
+
+    _growable.def(
+        "append",
+        [](type &_g, Tp _value) {
+          auto _n = _g.size();
+          _g.resize(_n + 1);
+          if constexpr (host_accessible) {
+            _g.m_view(_n) = _value;
+          } else {
+            using functor_t = Impl::growable_view_fill_functor<dynamic_t, Tp>;
+            py::gil_scoped_release _nogil{};
+            Kokkos::parallel_for("pykokkos_growable_view_append",
+                                 Kokkos::RangePolicy<exec_t>(0, 1),
+                                 functor_t{_g.m_view, _value, _n});
+            exec_t{}.fence();
+          }
+        },
+        "Append an element, growing the extent geometrically when needed",
+        py::arg("value"));
+
+    _growable.def(
+        "extend",
+        [](type &_g, const view_t &_view) {
+          using functor_t =
+              Impl::growable_view_copy_functor<dynamic_t, flat_view_t>;
+          auto _n = _g.size();
+          _g.resize(_n + _view.extent(0));
+          py::gil_scoped_release _nogil{};
+          Kokkos::parallel_for(
+              "pykokkos_growable_view_extend",
+              Kokkos::RangePolicy<exec_t>(0, _view.extent(0)),
+              functor_t{_g.m_view, Impl::get_flat_view(_view), _n});
+          exec_t{}.fence();
+        },
+        "Append the elements of a one-dimensional view in parallel",
+        py::arg("view"));
+
+    _growable.def(
+        "resize_serial", [](type &_g, size_t _n) { _g.resize(_n); },
+        "Set the number of elements. New elements are not initialized",
+        py::arg("size"));
+    _growable.def(
+        "reserve", [](type &_g, size_t _n) { _g.reserve(_n); },
+        "Allocate the chunks for at least the given number of elements",
+        py::arg("size"));
+    _growable.def(
+        "clear", [](type &_g) { _g.m_size = 0; },
+        "Remove every element without releasing the chunks");
+
+    _growable.def(
+        "size", [](type &_g) { return _g.size(); }, "Number of elements");
+    _growable.def(
+        "__len__", [](type &_g) { return _g.size(); }, "Number of elements");
+    _growable.def(
+        "capacity", [](type &_g) { return _g.capacity(); },
+        "Number of elements which can be stored without allocating chunks");
+
+    _growable.def(
+        "to_view",
+        [](type &_g) {
+          using functor_t =
+              Impl::growable_view_copy_functor<flat_view_t, dynamic_t>;
+          auto _view = view_t{_g.m_view.label(), _g.size()};
+          py::gil_scoped_release _nogil{};
+          Kokkos::parallel_for(
+              "pykokkos_growable_view_to_view",
+              Kokkos::RangePolicy<exec_t>(0, _g.size()),
+              functor_t{Impl::get_flat_view(_view), _g.m_view, 0});
+          exec_t{}.fence();
+          return _view;
+        },
+        "Copy the elements into a contiguous one-dimensional view");
+
+    if constexpr (host_accessible) {
+      _growable.def(
+          "__getitem__",
+          [](type &_g, size_t _i) {
+            check_index(_g, _i);
+            return _g.m_view(_i);
+          },
+          "Get the element");
+      _growable.def(
+          "__setitem__",
+          [](type &_g, size_t _i, Tp _value) {
+            check_index(_g, _i);
+            _g.m_view(_i) = _value;
+          },
+          "Set the element");
+    }
+
+    _growable.def_property_readonly(
+        "label", [](type &_g) { return _g.m_view.label(); },
+        "Label of the view");
+    _growable.def_property_readonly(
+        "dtype", [](type &) { return ViewDataTypeIndex<Tp>::value; },
+        "Data type of the view");
+    _growable.def_property_readonly(
+        "space", [](type &) { return MemorySpaceIndex<Sp>::value; },
+        "Memory space of the view");
+    _growable.def_property_readonly(
+        "cpp_type", [](type &) { return demangle<dynamic_t>(); },
+        "C++ type of the underlying view");
+  }
+};
+
+template <size_t DataIdx, size_t SpaceIdx>
+void generate_growable_view_variant(
+    py::module &,
+    std::enable_if_t<!is_available<memory_space_t<SpaceIdx>>::value, int> = 0) {
+}
+
+template <size_t DataIdx, size_t SpaceIdx>
+void generate_growable_view_variant(
+    py::module &_mod,
+    std::enable_if_t<is_available<memory_space_t<SpaceIdx>>::value, int> = 0) {
+  generate_pyclass<growable_view_variant<DataIdx, SpaceIdx>>(_mod);
+}
+}  // namespace SpaceDim
+}  // namespace Space
+
+namespace variants {
+// expand for every memory space
+template <size_t DataIdx, size_t... SpaceIdx>
+void generate_growable_view_variant(py::module &_mod,
+                                    std::index_sequence<SpaceIdx...>) {
+  FOLD_EXPRESSION(
+      Space::SpaceDim::generate_growable_view_variant<DataIdx, SpaceIdx>(
+          _mod));
+}
+}  // namespace variants
+
+namespace {
+// generate data type growable views for each memory space
+template <size_t... DataIdx>
+void generate_growable_view_variant(py::module &_mod,
+                                    std::index_sequence<DataIdx...>) {
+  FOLD_EXPRESSION(variants::generate_growable_view_variant<DataIdx>(
+      _mod, std::make_index_sequence<MemorySpacesEnd>{}));
+}
+}  // namespace
@@ -0,0 +1,246 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include <Kokkos_OffsetView.hpp>
+#include <array>
+#include <iostream>
+#include <string>
+
+#include "common.hpp"
+#include "concepts.hpp"
+#include "traits.hpp"
+#include "views.hpp"
+
+//----------------------------------------------------------------------------//
+//
+//                 Kokkos::Experimental::OffsetView bindings
+//
+//----------------------------------------------------------------------------//
+
+namespace Space {
+namespace SpaceDim {
+
+// the types and the python class name for a Kokkos::Experimental::OffsetView
+// whose storage is the fixed rank view in the given memory space
+template <size_t DataIdx, size_t SpaceIdx, size_t DimIdx, size_t LayoutIdx>
+struct offset_view_variant {
+  using data_spec_t   = ViewDataTypeSpecialization<DataIdx>;
+  using space_spec_t  = MemorySpaceSpecialization<SpaceIdx>;
+  using layout_spec_t = MemoryLayoutSpecialization<LayoutIdx>;
+  using Tp            = typename data_spec_t::type;
+  using Vp            = typename ViewDataTypeRepr<Tp, DimIdx>::type;
+  using Sp            = typename space_spec_t::type;
+  using Lp            = typename layout_spec_t::type;
+  using type          = Kokkos::Experimental::OffsetView<Vp, Lp, Sp>;
+  using view_t        = kokkos_python_view_type_t<typename type::view_type>;
+  using index_array_t = std::array<int64_t, DimIdx + 1>;
+
+  static constexpr auto sequence = std::make_index_sequence<DimIdx + 1>{};
+  static constexpr bool host_accessible =
+      Kokkos::SpaceAccessibility<Kokkos::HostSpace, Sp>::accessible;
+
+  static std::string name() {
+    return join("_", "KokkosOffsetView", data_spec_t::label(),
+                space_spec_t::label(), layout_spec_t::label(), DimIdx + 1);
+  }
+
+  template <size_t... Idx>
+  static type construct(const view_t &_view, const index_array_t &_begins,
+                        std::index_sequence<Idx...>) {
+    return type{_view, typename type::begins_type{_begins[Idx]...}};
+  }
+
+  template <size_t... Idx>
+  static index_array_t get_begins(type &_v, std::index_sequence<Idx...>) {
+    return index_array_t{static_cast<int64_t>(_v.begin(Idx))...};
+  }
+
+  template <size_t... Idx>
+  static index_array_t get_ends(type &_v, std::index_sequence<Idx...>) {
+    return index_array_t{static_cast<int64_t>(_v.end(Idx))...};
+  }
+
+  // the element at the shifted indices after checking that every index is
+  // in [begin, end) for its dimension
+  template <size_t... Idx>
+  static Tp &get_element(type &_v, const index_array_t &_idx,
+                         std::index_sequence<Idx...>) {
+    for (size_t i = 0; i < _idx.size(); ++i) {
+      if (_idx[i] < static_cast<int64_t>(_v.begin(i)) ||
+          _idx[i] >= static_cast<int64_t>(_v.end(i)))
+        throw py::index_error(
+            "Error! Index " + std::to_string(_idx[i]) + " of dimension " +
+            std::to_string(i) + " is outside of [" +
+            std::to_string(_v.begin(i)) + ", " + std::to_string(_v.end(i)) +
+            ")");
+    }
+    return _v(_idx[Idx]...);
+  }
+
+  static void generate(py::module &_mod) {
+    if (!add_pyclass<type>()) return;
+
+    auto _name = name();
+    if (debug_output())
+      std::cerr << "Registering " << demangle<type>() << " as python class '"
+                << _name << "'..." << std::endl;
+
+    // the offset view shares the allocation of the generated view class
+    ensure_pyclass<view_t>(_mod);
+
+    py::class_<type> _offset(_mod, _name.c_str());
+
+    _offset.def(py::init([](const view_t &_view, index_array_t _begins) {
+                  return construct(_view, _begins, sequence);
+                }),
+                "Index the view starting at the given index of each dimension "
+                "without copying",
+                py::arg("view"), py::arg("begins"), py::keep_alive<1, 2>());
+
+    _offset.def(
+        "view", [](type &_v) { return static_cast<view_t>(_v.view()); },
+        "Get the zero-based view which shares the allocation",
+        py::keep_alive<0, 1>());
+
+    if constexpr (host_accessible) {
+      _offset.def(
+          "__getitem__",
+          [](type &_v, index_array_t _idx) {
+            return get_element(_v, _idx, sequence);
+          },
+          "Get the element at the shifted indices");
+      _offset.def(
+          "__setitem__",
+          [](type &_v, index_array_t _idx, Tp _value) {
+            get_element(_v, _idx, sequence) = _value;
+          },
+          "Set the element at the shifted indices");
+      if constexpr (DimIdx == 0) {
+        _offset.def(
+            "__getitem__",
+            [](type &_v, int64_t _i) {
+              return get_element(_v, index_array_t{_i}, sequence);
+            },
+            "Get the element at the shifted index");
+        _offset.def(
+            "__setitem__",
+            [](type &_v, int64_t _i, Tp _value) {
+              get_element(_v, index_array_t{_i}, sequence) = _value;
+            },
+            "Set the element at the shifted index");
+      }
+    }
+
+    _offset.def_property_readonly(
+        "begins", [](type &_v) { return get_begins(_v, sequence); },
+        "First index of each dimension");
+    _offset.def_property_readonly(
+        "ends", [](type &_v) { return get_ends(_v, sequence); },
+        "One past the last index of each dimension");
+    _offset.def_property_readonly(
+        "shape", [](type &_v) { return get_extents(_v, sequence); },
+        "Get the shape of the view (extents)");
+    _offset.def_property_readonly(
+        "ndim", [](type &) { return DimIdx + 1; }, "Number of dimensions");
+    _offset.def_property_readonly(
+        "label", [](type &_v) { return _v.label(); }, "Label of the view");
+    _offset.def_property_readonly(
+        "dtype", [](type &) { return ViewDataTypeIndex<Tp>::value; },
+        "Data type of the view");
+    _offset.def_property_readonly(
+        "space", [](type &) { return MemorySpaceIndex<Sp>::value; },
+        "Memory space of the view");
+    _offset.def_property_readonly(
+        "layout", [](type &) { return MemoryLayoutIndex<Lp>::value; },
+        "Memory layout of the view");
+  }
+};
+
+template <size_t DataIdx, size_t SpaceIdx, size_t DimIdx, size_t LayoutIdx>
+void generate_offset_view_variant(py::module &_mod) {
+  generate_pyclass<offset_view_variant<DataIdx, SpaceIdx, DimIdx, LayoutIdx>>(
+      _mod);
+}
+}  // namespace SpaceDim
+
+// if the space is not available do nothing
+template <size_t LayoutIdx, size_t DataIdx, size_t SpaceIdx, size_t... DimIdx>
+void generate_offset_view_variant(
+    py::module &, std::index_sequence<DimIdx...>,
+    std::enable_if_t<!is_available<memory_space_t<SpaceIdx>>::value, int> = 0) {
+}
+
+// if the space is available expand for every dimension
+template <size_t LayoutIdx, size_t DataIdx, size_t SpaceIdx, size_t... DimIdx>
+void generate_offset_view_variant(
+    py::module &_mod, std::index_sequence<DimIdx...>,
+    std::enable_if_t<is_available<memory_space_t<SpaceIdx>>::value, int> = 0) {
+  FOLD_EXPRESSION(
+      SpaceDim::generate_offset_view_variant<DataIdx, SpaceIdx, DimIdx,
+                                             LayoutIdx>(_mod));
+}
+}  // namespace Space
+
+namespace variants {
+// expand for all the spaces with a given layout and data-type
+template <size_t LayoutIdx, size_t DataIdx, size_t... SpaceIdx>
+void generate_offset_view_variant(py::module &_mod,
+                                  std::index_sequence<SpaceIdx...>) {
+  FOLD_EXPRESSION(
+      Space::generate_offset_view_variant<LayoutIdx, DataIdx, SpaceIdx>(
+          _mod, std::make_index_sequence<ViewDataMaxDimensions>{}));
+}
+}  // namespace variants
+
+namespace {
+// generate data type offset views for each memory space
+template <size_t LayoutIdx, size_t... DataIdx>
+void generate_offset_view_variant(py::module &_mod,
+                                  std::index_sequence<DataIdx...>) {
+  FOLD_EXPRESSION(variants::generate_offset_view_variant<LayoutIdx, DataIdx>(
+      _mod, std::make_index_sequence<MemorySpacesEnd>{}));
+}
+}  // namespace
@@ -0,0 +1,312 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include <Kokkos_ScatterView.hpp>
+#include <iostream>
+#include <string>
+
+#include "common.hpp"
+#include "concepts.hpp"
+#include "traits.hpp"
+#include "views.hpp"
+
+//----------------------------------------------------------------------------//
+//
+//                     Kokkos::Experimental::ScatterView bindings
+//
+//----------------------------------------------------------------------------//
+
+namespace Impl {
+template <size_t OpIdx>
+struct scatter_op;
+
+template <>
+struct scatter_op<0> {
+  using type = Kokkos::Experimental::ScatterSum;
+  static std::string label() { return "sum"; }
+};
+
+template <>
+struct scatter_op<1> {
+  using type = Kokkos::Experimental::ScatterProd;
+  static std::string label() { return "prod"; }
+};
+
+template <>
+struct scatter_op<2> {
+  using type = Kokkos::Experimental::ScatterMin;
+  static std::string label() { return "min"; }
+};
+
+template <>
+struct scatter_op<3> {
+  using type = Kokkos::Experimental::ScatterMax;
+  static std::string label() { return "max"; }
+};
+
+static constexpr size_t ScatterOpsEnd = 4;
+
+// the contribution of values(i) to the element indices(i)
+template <typename ScatterT, typename IndexT, typename ValueT>
+struct scatter_view_functor {
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t i) const {
+    auto _access = m_scatter.access();
+    _access(m_indices(i)).update(m_values(i));
+  }
+
+  ScatterT m_scatter;
+  IndexT m_indices;
+  ValueT m_values;
+};
+
+// the smallest and the largest index so the range is checked before the
+// scatter writes through them
+template <typename IndexT>
+struct scatter_index_range_functor {
+  using index_type  = typename IndexT::non_const_value_type;
+  using reducer_t   = Kokkos::MinMax<index_type>;
+  using minmax_type = typename reducer_t::value_type;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t i, minmax_type &_range) const {
+    const index_type _idx = m_indices(i);
+    if (_idx < _range.min_val) _range.min_val = _idx;
+    if (_idx > _range.max_val) _range.max_val = _idx;
+  }
+
+  IndexT m_indices;
+};
+}  // namespace Impl
+
+namespace Space {
+namespace SpaceDim {
+
+// the types and the python class name for a one-dimensional ScatterView
+// which is either duplicated (one copy per thread, non-atomic updates) or
+// non-duplicated with atomic updates
+template <size_t DataIdx, size_t SpaceIdx, size_t OpIdx, bool DuplicatedV>
+struct scatter_view_variant {
+  using data_spec_t  = ViewDataTypeSpecialization<DataIdx>;
+  using space_spec_t = MemorySpaceSpecialization<SpaceIdx>;
+  using op_spec_t    = Impl::scatter_op<OpIdx>;
+  using Tp           = typename data_spec_t::type;
+  using Sp           = typename space_spec_t::type;
+  using Op           = typename op_spec_t::type;
+  using exec_t       = typename Sp::execution_space;
+  using device_t     = Kokkos::Device<exec_t, Sp>;
+  using duplication_t =
+      std::conditional_t<DuplicatedV, Kokkos::Experimental::ScatterDuplicated,
+                         Kokkos::Experimental::ScatterNonDuplicated>;
+  using contribution_t =
+      std::conditional_t<DuplicatedV, Kokkos::Experimental::ScatterNonAtomic,
+                         Kokkos::Experimental::ScatterAtomic>;
+  using type   = Kokkos::Experimental::ScatterView<Tp *, Kokkos::LayoutRight,
+                                                 device_t, Op, duplication_t,
+                                                 contribution_t>;
+  using view_t = kokkos_python_view_1d_t<Tp, Sp>;
+
+  static std::string name() {
+    return join("_", "KokkosScatterView", data_spec_t::label(),
+                space_spec_t::label(), op_spec_t::label(),
+                (DuplicatedV) ? "duplicated" : "atomic");
+  }
+
+  template <typename Kp>
+  static void scatter(type &_scatter,
+                      const kokkos_python_view_1d_t<Kp, Sp> &_idx,
+                      const view_t &_values) {
+    using functor_t =
+        Impl::scatter_view_functor<type, Impl::flat_view_t<Kp, Sp>,
+                                   Impl::flat_view_t<Tp, Sp>>;
+    using range_functor_t =
+        Impl::scatter_index_range_functor<Impl::flat_view_t<Kp, Sp>>;
+    if (_idx.extent(0) != _values.extent(0))
+      throw py::value_error("Error! indices and values have different extents");
+    if (_idx.extent(0) == 0) return;
+
+    auto _range = typename range_functor_t::minmax_type{};
+    {
+      py::gil_scoped_release _nogil{};
+      Kokkos::parallel_reduce(
+          "pykokkos_scatter_view_index_range",
+          Kokkos::RangePolicy<exec_t>(0, _idx.extent(0)),
+          range_functor_t{Impl::get_flat_view(_idx)},
+          typename range_functor_t::reducer_t{_range});
+    }
+    if (_range.min_val < 0 ||
+        static_cast<size_t>(_range.max_val) >= _scatter.extent(0))
+      throw py::index_error(
+          "Error! The indices range from " + std::to_string(_range.min_val) +
+          " to " + std::to_string(_range.max_val) +
+          " but the view has an extent of " +
+          std::to_string(_scatter.extent(0)));
+
+    py::gil_scoped_release _nogil{};
+    Kokkos::parallel_for(
+        "pykokkos_scatter_view", Kokkos::RangePolicy<exec_t>(0, _idx.extent(0)),
+        functor_t{_scatter, Impl::get_flat_view(_idx),
+                  Impl::get_flat_view(_values)});
+    exec_t{}.fence();
+  }
+
+  static void generate(py::module &_mod) {
+    if (!add_pyclass<type>()) return;
+
+    auto _name = name();
+    if (debug_output())
+      std::cerr << "Registering " << demangle<type>() << " as python class '"
+                << _name << "'..." << std::endl;
+
+    py::class_<type> _scatter(_mod, _name.c_str());
+
+    _scatter.def(py::init([](const view_t &_view) { return new type{_view}; }),
+                 "Scatter into the given view. Without duplication, the "
+                 "updates are applied atomically to the view itself",
+                 py::arg("view"), py::keep_alive<1, 2>());
+
+    _scatter.def(
+        "scatter",
+        [](type &_s, const kokkos_python_view_1d_t<int32_t, Sp> &_idx,
+           const view_t &_values) { scatter<int32_t>(_s, _idx, _values); },
+        "Apply the operation to the elements at the indices with the values "
+        "in parallel",
+        py::arg("indices"), py::arg("values"));
+    _scatter.def(
+        "scatter",
+        [](type &_s, const kokkos_python_view_1d_t<int64_t, Sp> &_idx,
+           const view_t &_values) { scatter<int64_t>(_s, _idx, _values); },
+        "Apply the operation to the elements at the indices with the values "
+        "in parallel",
+        py::arg("indices"), py::arg("values"));
+
+    _scatter.def(
+        "contribute_into",
+        [](type &_s, view_t &_view) {
+          py::gil_scoped_release _nogil{};
+          Kokkos::Experimental::contribute(_view, _s);
+          exec_t{}.fence();
+        },
+        "Combine the contributions into the view (a no-op when the updates "
+        "were applied to the view itself)",
+        py::arg("view"));
+
+    _scatter.def(
+        "reset",
+        [](type &_s) {
+          py::gil_scoped_release _nogil{};
+          _s.reset();
+          exec_t{}.fence();
+        },
+        "Reset the contributions to the identity of the operation");
+
+    _scatter.def_property_readonly(
+        "duplicated", [](type &) { return DuplicatedV; },
+        "Whether every thread has a copy (otherwise updates are atomic)");
+    _scatter.def_property_readonly(
+        "operation", [](type &) { return op_spec_t::label(); },
+        "Operation applied to the contributions");
+    _scatter.def_property_readonly(
+        "dtype", [](type &) { return ViewDataTypeIndex<Tp>::value; },
+        "Data type of the view");
+    _scatter.def_property_readonly(
+        "space", [](type &) { return MemorySpaceIndex<Sp>::value; },
+        "Memory space of the view");
+  }
+};
+
+template <size_t DataIdx, size_t SpaceIdx, size_t OpIdx>
+void generate_scatter_view_variant(
+    py::module &,
+    std::enable_if_t<!is_available<memory_space_t<SpaceIdx>>::value, int> = 0) {
+}
+
+template <size_t DataIdx, size_t SpaceIdx, size_t OpIdx>
+void generate_scatter_view_variant(
+    py::module &_mod,
+    std::enable_if_t<is_available<memory_space_t<SpaceIdx>>::value, int> = 0) {
+  using Sp = memory_space_t<SpaceIdx>;
+
+  generate_pyclass<scatter_view_variant<DataIdx, SpaceIdx, OpIdx, false>>(
+      _mod);
+  // duplication is the approach for the host execution spaces
+  if constexpr (Kokkos::SpaceAccessibility<typename Sp::execution_space,
+                                           Kokkos::HostSpace>::accessible) {
+    generate_pyclass<scatter_view_variant<DataIdx, SpaceIdx, OpIdx, true>>(
+        _mod);
+  }
+}
+}  // namespace SpaceDim
+
+// expand for every operation
+template <size_t DataIdx, size_t SpaceIdx, size_t... OpIdx>
+void generate_scatter_view_variant(py::module &_mod,
+                                   std::index_sequence<OpIdx...>) {
+  FOLD_EXPRESSION(
+      SpaceDim::generate_scatter_view_variant<DataIdx, SpaceIdx, OpIdx>(
+          _mod));
+}
+}  // namespace Space
+
+namespace variants {
+// expand for every memory space
+template <size_t DataIdx, size_t... SpaceIdx>
+void generate_scatter_view_variant(py::module &_mod,
+                                   std::index_sequence<SpaceIdx...>) {
+  FOLD_EXPRESSION(Space::generate_scatter_view_variant<DataIdx, SpaceIdx>(
+      _mod, std::make_index_sequence<Impl::ScatterOpsEnd>{}));
+}
+}  // namespace variants
+
+namespace {
+// generate data type scatter views for each memory space
+template <size_t... DataIdx>
+void generate_scatter_view_variant(py::module &_mod,
+                                   std::index_sequence<DataIdx...>) {
+  FOLD_EXPRESSION(variants::generate_scatter_view_variant<DataIdx>(
+      _mod, std::make_index_sequence<MemorySpacesEnd>{}));
+}
+}  // namespace
@@ -0,0 +1,454 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include <Kokkos_UnorderedMap.hpp>
+#include <iostream>
+#include <string>
+#include <tuple>
+
+#include "common.hpp"
+#include "concepts.hpp"
+#include "traits.hpp"
+#include "views.hpp"
+
+//----------------------------------------------------------------------------//
+//
+//                      Bulk operations on Kokkos::UnorderedMap
+//
+//----------------------------------------------------------------------------//
+
+namespace Impl {
+// erase only has an effect between begin_erase() and end_erase() in the
+// Kokkos versions which provide them
+template <typename MapT>
+auto begin_erase(MapT &_map, int) -> decltype(_map.begin_erase(), void()) {
+  _map.begin_erase();
+}
+
+template <typename MapT>
+void begin_erase(MapT &, long) {}
+
+template <typename MapT>
+auto end_erase(MapT &_map, int) -> decltype(_map.end_erase(), void()) {
+  _map.end_erase();
+}
+
+template <typename MapT>
+void end_erase(MapT &, long) {}
+
+// counts the failed insertions (i.e. the capacity was exceeded)
+template <typename MapT, typename KeyT, typename ValueT>
+struct unordered_map_insert_functor {
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t i, size_t &_failed) const {
+    if constexpr (MapT::is_set) {
+      if (m_map.insert(m_keys(i)).failed()) ++_failed;
+    } else {
+      if (m_map.insert(m_keys(i), m_values(i)).failed()) ++_failed;
+    }
+  }
+
+  MapT m_map;
+  KeyT m_keys;
+  ValueT m_values;
+};
+
+template <typename MapT, typename KeyT, typename ValueT, typename MaskT>
+struct unordered_map_find_functor {
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t i) const {
+    auto _idx   = m_map.find(m_keys(i));
+    bool _found = m_map.valid_at(_idx);
+    m_found(i)  = (_found) ? 1 : 0;
+    if constexpr (!MapT::is_set) {
+      using value_type = typename ValueT::non_const_value_type;
+      m_values(i)      = (_found) ? m_map.value_at(_idx) : value_type{};
+    }
+  }
+
+  MapT m_map;
+  KeyT m_keys;
+  ValueT m_values;
+  MaskT m_found;
+};
+
+template <typename MapT, typename KeyT>
+struct unordered_map_erase_functor {
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t i, size_t &_erased) const {
+    if (m_map.erase(m_keys(i))) ++_erased;
+  }
+
+  MapT m_map;
+  KeyT m_keys;
+};
+
+// compacts the valid entries into contiguous key (and value) views
+template <typename MapT, typename KeyT, typename ValueT>
+struct unordered_map_export_functor {
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const uint32_t i, size_t &_offset, const bool _final) const {
+    if (!m_map.valid_at(i)) return;
+    if (_final) {
+      m_keys(_offset) = m_map.key_at(i);
+      if constexpr (!MapT::is_set) m_values(_offset) = m_map.value_at(i);
+    }
+    ++_offset;
+  }
+
+  MapT m_map;
+  KeyT m_keys;
+  ValueT m_values;
+};
+
+template <size_t ValueIdx, bool = (ValueIdx < ViewDataTypesEnd)>
+struct unordered_map_value {
+  using type = typename ViewDataTypeSpecialization<ValueIdx>::type;
+  static std::string label() {
+    return ViewDataTypeSpecialization<ValueIdx>::label();
+  }
+};
+
+// ViewDataTypesEnd is used for Kokkos::UnorderedMap<Key, void>, i.e. a set
+template <size_t ValueIdx>
+struct unordered_map_value<ValueIdx, false> {
+  using type = void;
+  static std::string label() { return std::string{}; }
+};
+}  // namespace Impl
+
+//----------------------------------------------------------------------------//
+//
+//                          Kokkos::UnorderedMap bindings
+//
+//----------------------------------------------------------------------------//
+
+namespace Space {
+namespace SpaceDim {
+
+// the types and the python class name for a Kokkos::UnorderedMap (or a set
+// when ValueIdx is ViewDataTypesEnd) in the given memory space
+template <size_t KeyIdx, size_t ValueIdx, size_t SpaceIdx>
+struct unordered_map_variant {
+  using key_spec_t   = ViewDataTypeSpecialization<KeyIdx>;
+  using value_spec_t = Impl::unordered_map_value<ValueIdx>;
+  using space_spec_t = MemorySpaceSpecialization<SpaceIdx>;
+  using Kp           = typename key_spec_t::type;
+  using Vp           = typename value_spec_t::type;
+  using Sp           = typename space_spec_t::type;
+  using exec_t       = typename Sp::execution_space;
+  using device_t     = Kokkos::Device<exec_t, Sp>;
+  using type         = Kokkos::UnorderedMap<Kp, Vp, device_t>;
+  // a set has no values so uint8_t is used as a placeholder
+  using value_t      = std::conditional_t<type::is_set, uint8_t, Vp>;
+  using key_view_t   = kokkos_python_view_1d_t<Kp, Sp>;
+  using value_view_t = kokkos_python_view_1d_t<value_t, Sp>;
+  using mask_view_t  = kokkos_python_view_1d_t<uint8_t, Sp>;
+  using flat_key_t   = Impl::flat_view_t<Kp, Sp>;
+  using flat_value_t = Impl::flat_view_t<value_t, Sp>;
+  using flat_mask_t  = Impl::flat_view_t<uint8_t, Sp>;
+
+  static std::string name() {
+    if (type::is_set)
+      return join("_", "KokkosUnorderedSet", key_spec_t::label(),
+                  space_spec_t::label());
+    return join("_", "KokkosUnorderedMap", key_spec_t::label(),
+                value_spec_t::label(), space_spec_t::label());
+  }
+
+  static size_t insert(type &_map, const key_view_t &_keys,
+                       const value_view_t &_values, bool _rehash) {
+    using functor_t =
+        Impl::unordered_map_insert_functor<type, flat_key_t, flat_value_t>;
+
+    auto _n = _keys.extent(0);
+    if (!type::is_set && _values.extent(0) != _n)
+      throw py::value_error("Error! keys and values have different extents");
+
+    auto _flat_keys   = Impl::get_flat_view(_keys);
+    auto _flat_values = (type::is_set) ? flat_value_t{}
+                                       : Impl::get_flat_view(_values);
+
+    py::gil_scoped_release _nogil{};
+    size_t _failed = 0;
+    Kokkos::parallel_reduce("pykokkos_unordered_map_insert",
+                            Kokkos::RangePolicy<exec_t>(0, _n),
+                            functor_t{_map, _flat_keys, _flat_values},
+                            _failed);
+    // grow and insert the remaining keys (inserted keys are reported as
+    // existing on the second pass). rehash replaces the storage of the map
+    // so the functor has to be rebuilt from the rehashed map
+    while (_rehash && _failed > 0) {
+      _map.rehash(2 * _map.capacity() + _failed);
+      _failed = 0;
+      Kokkos::parallel_reduce("pykokkos_unordered_map_insert",
+                              Kokkos::RangePolicy<exec_t>(0, _n),
+                              functor_t{_map, _flat_keys, _flat_values},
+                              _failed);
+    }
+    return _failed;
+  }
+
+  static void generate(py::module &_mod) {
+    if (!add_pyclass<type>()) return;
+
+    auto _name = name();
+    if (debug_output())
+      std::cerr << "Registering " << demangle<type>() << " as python class '"
+                << _name << "'..." << std::endl;
+
+    // the bulk operations return the generated view classes
+    ensure_pyclass<key_view_t>(_mod);
+    ensure_pyclass<mask_view_t>(_mod);
+    ensure_pyclass<value_view_t>(_mod);
+
+    py::class_<type> _map(_mod, _name.c_str());
+
+    _map.def(py::init([](uint32_t _capacity) { return new type{_capacity}; }),
+             py::arg("capacity") = 0);
+
+    _map.def_property_readonly(
+        "capacity", [](type &_m) { return _m.capacity(); },
+        "Number of entries the table can hold before it has to be rehashed");
+    _map.def(
+        "size", [](type &_m) { return _m.size(); },
+        "Number of entries in the table");
+    _map.def(
+        "__len__", [](type &_m) { return _m.size(); },
+        "Number of entries in the table");
+    _map.def(
+        "rehash",
+        [](type &_m, uint32_t _capacity) {
+          py::gil_scoped_release _nogil{};
+          return _m.rehash(_capacity);
+        },
+        "Change the capacity (never below the current size)",
+        py::arg("capacity"));
+    _map.def(
+        "clear",
+        [](type &_m) {
+          py::gil_scoped_release _nogil{};
+          _m.clear();
+        },
+        "Remove all the entries");
+    _map.def(
+        "failed_insert", [](type &_m) { return _m.failed_insert(); },
+        "Whether an insertion failed since the last rehash");
+
+    // the counts of the keys which were inserted, were already present, or
+    // could not be inserted because the capacity was exceeded
+    auto _insert_counts = [](type &_m, size_t _n, size_t _size,
+                             size_t _failed) {
+      auto _success = _m.size() - _size;
+      py::dict _counts{};
+      _counts["success"]  = _success;
+      _counts["existing"] = _n - _success - _failed;
+      _counts["failed"]   = _failed;
+      return _counts;
+    };
+
+    if constexpr (type::is_set) {
+      _map.def(
+          "insert",
+          [_insert_counts](type &_m, const key_view_t &_keys, bool _rehash) {
+            auto _size   = _m.size();
+            auto _failed = insert(_m, _keys, value_view_t{}, _rehash);
+            return _insert_counts(_m, _keys.extent(0), _size, _failed);
+          },
+          "Insert the keys in parallel. Unless rehash=False, the capacity "
+          "grows until every key fits. Returns the success/existing/failed "
+          "counts",
+          py::arg("keys"), py::arg("rehash") = true);
+
+      _map.def(
+          "contains",
+          [](type &_m, const key_view_t &_keys) {
+            using functor_t =
+                Impl::unordered_map_find_functor<type, flat_key_t,
+                                                 flat_value_t, flat_mask_t>;
+            auto _n     = _keys.extent(0);
+            auto _found = mask_view_t{"found", _n};
+            {
+              py::gil_scoped_release _nogil{};
+              Kokkos::parallel_for(
+                  "pykokkos_unordered_map_find",
+                  Kokkos::RangePolicy<exec_t>(0, _n),
+                  functor_t{_m, Impl::get_flat_view(_keys), flat_value_t{},
+                            Impl::get_flat_view(_found)});
+              exec_t{}.fence();
+            }
+            return _found;
+          },
+          "Look up the keys in parallel. Returns a uint8 view which is 1 "
+          "where the key is present",
+          py::arg("keys"));
+    } else {
+      _map.def(
+          "insert",
+          [_insert_counts](type &_m, const key_view_t &_keys,
+                           const value_view_t &_values, bool _rehash) {
+            auto _size   = _m.size();
+            auto _failed = insert(_m, _keys, _values, _rehash);
+            return _insert_counts(_m, _keys.extent(0), _size, _failed);
+          },
+          "Insert the key-value pairs in parallel (existing keys keep their "
+          "value). Unless rehash=False, the capacity grows until every key "
+          "fits. Returns the success/existing/failed counts",
+          py::arg("keys"), py::arg("values"), py::arg("rehash") = true);
+
+      _map.def(
+          "find",
+          [](type &_m, const key_view_t &_keys) {
+            using functor_t =
+                Impl::unordered_map_find_functor<type, flat_key_t,
+                                                 flat_value_t, flat_mask_t>;
+            auto _n      = _keys.extent(0);
+            auto _values = value_view_t{"values", _n};
+            auto _found  = mask_view_t{"found", _n};
+            {
+              py::gil_scoped_release _nogil{};
+              Kokkos::parallel_for(
+                  "pykokkos_unordered_map_find",
+                  Kokkos::RangePolicy<exec_t>(0, _n),
+                  functor_t{_m, Impl::get_flat_view(_keys),
+                            Impl::get_flat_view(_values),
+                            Impl::get_flat_view(_found)});
+              exec_t{}.fence();
+            }
+            return std::make_tuple(_values, _found);
+          },
+          "Look up the keys in parallel. Returns the values (zero where the "
+          "key is missing) and a uint8 view which is 1 where the key is "
+          "present",
+          py::arg("keys"));
+    }
+
+    _map.def(
+        "erase",
+        [](type &_m, const key_view_t &_keys) {
+          using functor_t = Impl::unordered_map_erase_functor<type, flat_key_t>;
+          py::gil_scoped_release _nogil{};
+          size_t _erased = 0;
+          Impl::begin_erase(_m, 0);
+          Kokkos::parallel_reduce(
+              "pykokkos_unordered_map_erase",
+              Kokkos::RangePolicy<exec_t>(0, _keys.extent(0)),
+              functor_t{_m, Impl::get_flat_view(_keys)}, _erased);
+          Impl::end_erase(_m, 0);
+          return _erased;
+        },
+        "Erase the keys in parallel. Returns the number of erased keys",
+        py::arg("keys"));
+
+    _map.def(
+        "export",
+        [](type &_m) -> py::object {
+          using functor_t =
+              Impl::unordered_map_export_functor<type, flat_key_t,
+                                                 flat_value_t>;
+          auto _n      = _m.size();
+          auto _keys   = key_view_t{"keys", _n};
+          auto _values = (type::is_set) ? value_view_t{}
+                                        : value_view_t{"values", _n};
+          {
+            py::gil_scoped_release _nogil{};
+            Kokkos::parallel_scan(
+                "pykokkos_unordered_map_export",
+                Kokkos::RangePolicy<exec_t, Kokkos::IndexType<uint32_t>>(
+                    0, _m.capacity()),
+                functor_t{_m, Impl::get_flat_view(_keys),
+                          (type::is_set) ? flat_value_t{}
+                                         : Impl::get_flat_view(_values)});
+            exec_t{}.fence();
+          }
+          if (type::is_set) return py::cast(_keys);
+          return py::cast(std::make_tuple(_keys, _values));
+        },
+        "Copy the entries into contiguous views: the keys for a set, the keys "
+        "and values for a map");
+
+    _map.def_property_readonly(
+        "key_dtype", [](type &) { return ViewDataTypeIndex<Kp>::value; },
+        "Data type of the keys");
+    _map.def_property_readonly(
+        "space", [](type &) { return MemorySpaceIndex<Sp>::value; },
+        "Memory space of the table");
+  }
+};
+
+template <size_t KeyIdx, size_t ValueIdx, size_t SpaceIdx>
+void generate_unordered_map_variant(
+    py::module &,
+    std::enable_if_t<!is_available<memory_space_t<SpaceIdx>>::value, int> = 0) {
+}
+
+template <size_t KeyIdx, size_t ValueIdx, size_t SpaceIdx>
+void generate_unordered_map_variant(
+    py::module &_mod,
+    std::enable_if_t<is_available<memory_space_t<SpaceIdx>>::value, int> = 0) {
+  generate_pyclass<unordered_map_variant<KeyIdx, ValueIdx, SpaceIdx>>(_mod);
+}
+}  // namespace SpaceDim
+
+// expand for every memory space
+template <size_t KeyIdx, size_t ValueIdx, size_t... SpaceIdx>
+void generate_unordered_map_variant(py::module &_mod,
+                                    std::index_sequence<SpaceIdx...>) {
+  FOLD_EXPRESSION(
+      SpaceDim::generate_unordered_map_variant<KeyIdx, ValueIdx, SpaceIdx>(
+          _mod));
+}
+}  // namespace Space
+
+namespace {
+// generate the maps for a key type with every value type plus the set
+template <size_t KeyIdx, size_t... ValueIdx>
+void generate_unordered_map_variant(py::module &_mod,
+                                    std::index_sequence<ValueIdx...>) {
+  FOLD_EXPRESSION(Space::generate_unordered_map_variant<KeyIdx, ValueIdx>(
+      _mod, std::make_index_sequence<MemorySpacesEnd>{}));
+}
+}  // namespace
@@ -0,0 +1,177 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_DynRankView.hpp>
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <utility>
+
+#include "common.hpp"
+#include "fwd.hpp"
+#include "traits.hpp"
+
+//----------------------------------------------------------------------------//
+//
+//                          Caching view allocator
+//
+//----------------------------------------------------------------------------//
+//
+//  When enabled, managed views constructed from python are retained by the
+//  cache. Once python drops its last reference, the cache holds the only
+//  reference and the allocation is handed out again to a later request in the
+//  same memory space instead of calling into the memory space. Entries are
+//  binned by their size in bytes per memory space and a request is served
+//  from the bins holding between one and two times the requested bytes.
+//  A tracked view cannot be reshaped, so an allocation of a different shape
+//  only serves one-dimensional views (as a subview of the leading elements);
+//  views of higher rank reuse allocations with the same extents.
+//  The free allocations beyond the limit of the memory space are released.
+//
+namespace view_cache {
+using extents_t = std::array<size_t, 8>;
+
+struct entry_base {
+  entry_base(std::type_index _type, const extents_t &_extents, size_t _bytes)
+      : type{_type}, extents(_extents), bytes{_bytes} {}
+  virtual ~entry_base() = default;
+
+  // the allocation is free when the cache holds the only reference
+  virtual bool in_use() const = 0;
+
+  std::type_index type;
+  extents_t extents;
+  size_t bytes;
+};
+
+template <typename ViewT>
+struct entry : entry_base {
+  entry(ViewT _view, const extents_t &_extents, size_t _bytes)
+      : entry_base{typeid(ViewT), _extents, _bytes}, view{std::move(_view)} {}
+
+  bool in_use() const override { return view.use_count() > 1; }
+
+  ViewT view;
+};
+
+// returns true if the free entry was used to serve the request
+using acquire_func_t = std::function<bool(entry_base *)>;
+
+bool enabled();
+
+// invokes _func with the cache lock held for the free entries of the same
+// type in the memory space until one of them serves the request
+bool acquire(size_t _space, size_t _bytes, std::type_index _type,
+             const acquire_func_t &_func);
+
+// adds the entry and releases the free entries beyond the limit of the
+// memory space (after the cache lock is released)
+void insert(size_t _space, const std::string &_space_label,
+            std::unique_ptr<entry_base> &&_entry);
+
+// skips the zero-initialization kernel when _initialize is false
+template <typename ViewT, typename... Args>
+ViewT construct(const std::string &_label, bool _initialize, Args... _args) {
+  if (_initialize) return ViewT{_label, _args...};
+  return ViewT{Kokkos::view_alloc(Kokkos::WithoutInitializing, _label),
+               _args...};
+}
+
+template <typename ViewT, typename... Args>
+ViewT *allocate(const std::string &_label, bool _initialize, Args... _args) {
+  if (!enabled())
+    return new ViewT{construct<ViewT>(_label, _initialize, _args...)};
+
+  using value_type   = typename ViewT::non_const_value_type;
+  using memory_space = typename ViewT::memory_space;
+  using space_spec_t =
+      MemorySpaceSpecialization<MemorySpaceIndex<memory_space>::value>;
+
+  constexpr size_t space_idx = MemorySpaceIndex<memory_space>::value;
+  constexpr bool is_subviewable =
+      sizeof...(Args) == 1 && !Kokkos::is_dyn_rank_view<ViewT>::value;
+
+  auto _extents = extents_t{static_cast<size_t>(_args)...};
+  auto _bytes   = sizeof(value_type);
+  FOLD_EXPRESSION(_bytes *= static_cast<size_t>(_args));
+
+  ViewT *_view  = nullptr;
+  auto _acquire = [&_view, &_extents](entry_base *_entry) {
+    auto &_cached = static_cast<entry<ViewT> *>(_entry)->view;
+    if (_entry->extents == _extents) {
+      _view = new ViewT{_cached};
+      return true;
+    }
+    if constexpr (is_subviewable) {
+      if (_entry->extents[0] >= _extents[0]) {
+        _view = new ViewT{Kokkos::subview(
+            _cached, std::make_pair(size_t{0}, _extents[0]))};
+        return true;
+      }
+    }
+    return false;
+  };
+
+  if (acquire(space_idx, _bytes, typeid(ViewT), _acquire)) {
+    // the previous owner may have left asynchronous kernels (e.g. fill_async
+    // or deep_copy_async) using the allocation in any execution space
+    Kokkos::fence("pykokkos_view_cache_reuse");
+    // reused allocations keep their original label but are zero-initialized
+    // like a new allocation
+    if (_initialize) Kokkos::deep_copy(*_view, value_type{});
+    return _view;
+  }
+
+  auto _entry = std::make_unique<entry<ViewT>>(
+      construct<ViewT>(_label, _initialize, _args...), _extents, _bytes);
+  _view       = new ViewT{_entry->view};
+  insert(space_idx, space_spec_t::label(), std::move(_entry));
+  return _view;
+}
+}  // namespace view_cache
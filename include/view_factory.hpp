@@ -0,0 +1,121 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include "common.hpp"
+#include "fwd.hpp"
+#include "view_cache.hpp"
+
+//----------------------------------------------------------------------------//
+//
+//  Table of the managed view variants indexed by the data type, memory space,
+//  layout, memory trait, and rank enumerations (the last rank slot is for
+//  Kokkos::DynRankView). kokkos.make_view uses this table to construct a view
+//  without building the python class name and looking it up on the module.
+//
+//----------------------------------------------------------------------------//
+
+namespace view_factory {
+using function_t = py::object (*)(const std::string &,
+                                  const std::vector<size_t> &, bool);
+
+struct entry {
+  const std::type_info *type = nullptr;
+  function_t create          = nullptr;
+  std::string label          = {};
+};
+
+static constexpr size_t DynamicRankIdx = ViewDataMaxDimensions;
+
+size_t get_index(size_t _dtype, size_t _space, size_t _layout, size_t _trait,
+                 size_t _rank);
+void add_entry(size_t _index, entry &&);
+
+template <typename ViewT, size_t... Idx>
+py::object create(const std::string &_label, const std::vector<size_t> &_shape,
+                  bool _initialize, std::index_sequence<Idx...>) {
+  return py::cast(
+      view_cache::allocate<ViewT>(_label, _initialize, _shape[Idx]...),
+      py::return_value_policy::take_ownership);
+}
+
+// dispatches on the number of extents: Idx + 1 for every Idx
+template <typename ViewT, size_t... Idx>
+py::object create(const std::string &_label, const std::vector<size_t> &_shape,
+                  bool _initialize) {
+  py::object _obj{};
+  FOLD_EXPRESSION(
+      (_shape.size() == Idx + 1)
+          ? (void)(_obj = create<ViewT>(_label, _shape, _initialize,
+                                        std::make_index_sequence<Idx + 1>{}))
+          : (void)0);
+  if (!_obj) {
+    std::stringstream ss;
+    ss << "Error! " << _shape.size()
+       << " extents is not supported for views of type "
+       << demangle<ViewT>();
+    throw py::value_error{ss.str()};
+  }
+  return _obj;
+}
+
+// VariantT provides the (uniform) view type and the enumeration indices
+template <typename VariantT, size_t RankIdx, size_t... Idx>
+void add(std::index_sequence<Idx...>) {
+  using view_type = typename VariantT::type;
+  // only managed views can be allocated from a label and extents
+  if constexpr (!view_type::traits::memory_traits::is_unmanaged) {
+    auto _index = get_index(VariantT::data_idx, VariantT::space_idx,
+                            VariantT::layout_idx, VariantT::trait_idx, RankIdx);
+    add_entry(_index, entry{&typeid(view_type), &create<view_type, Idx...>,
+                            VariantT::default_label()});
+  }
+}
+}  // namespace view_factory
@@ -0,0 +1,213 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+#include "async.hpp"
+#include "common.hpp"
+#include "fwd.hpp"
+#include "traits.hpp"
+
+//----------------------------------------------------------------------------//
+//
+//                       Binary save/load of views
+//
+//----------------------------------------------------------------------------//
+//
+//  A file is a fixed-size header, the label, and padding up to data_offset
+//  followed by the raw data of the view in memory order (native byte order).
+//  Host-accessible views are written from and read into their allocation
+//  directly, other views are staged through a host buffer of block_size
+//  bytes so the peak memory does not double.
+//
+namespace view_io {
+constexpr size_t block_size       = 64 * 1024 * 1024;
+constexpr size_t alignment        = 4096;
+constexpr size_t data_offset      = alignment;
+constexpr uint32_t format_version = 1;
+
+struct header {
+  char magic[8]        = {'P', 'Y', 'K', 'K', 'V', 'I', 'E', 'W'};
+  uint32_t version     = format_version;
+  uint32_t dtype       = 0;
+  uint32_t layout      = 0;
+  uint32_t rank        = 0;
+  uint32_t dynamic     = 0;
+  uint32_t label_size  = 0;
+  uint64_t extents[8]  = {};
+  uint64_t data_size   = 0;
+  uint64_t data_offset = view_io::data_offset;
+};
+
+static_assert(sizeof(header) < data_offset, "header must fit in data_offset");
+
+// the file descriptors for buffered and (when requested and supported by the
+// file system) O_DIRECT I/O. O_DIRECT requires aligned addresses, sizes,
+// and offsets so unaligned transfers use the buffered descriptor
+class file {
+ public:
+  file(const std::string &_path, bool _write, bool _direct);
+  ~file();
+
+  file(const file &) = delete;
+  file &operator=(const file &) = delete;
+
+  void write_header(const header &_header, const std::string &_label);
+  header read_header(std::string &_label);
+
+  void write(const void *_data, size_t _bytes, size_t _offset);
+  void read(void *_data, size_t _bytes, size_t _offset);
+
+ private:
+  // the aligned bounce buffer for O_DIRECT transfers of unaligned memory. It
+  // is allocated once per file with at most block_size bytes
+  char *get_block(size_t _bytes);
+
+  std::string m_path;
+  int m_fd            = -1;
+  int m_direct_fd     = -1;
+  void *m_block       = nullptr;
+  size_t m_block_size = 0;
+};
+
+// the header and label of the file
+header read_header(const std::string &_path, std::string &_label);
+
+// the transfers are done in blocks through a host buffer when the memory
+// space is not accessible from the host
+template <typename ViewT>
+void transfer(ViewT &_view, file &_file, bool _write) {
+  using value_type   = typename ViewT::non_const_value_type;
+  using memory_space = typename ViewT::memory_space;
+
+  auto _flat  = Impl::get_flat_view(_view);
+  auto _bytes = _flat.extent(0) * sizeof(value_type);
+
+  if constexpr (Kokkos::SpaceAccessibility<Kokkos::HostSpace,
+                                           memory_space>::accessible) {
+    if (_write)
+      _file.write(_flat.data(), _bytes, data_offset);
+    else
+      _file.read(_flat.data(), _bytes, data_offset);
+  } else {
+    using buffer_t          = Kokkos::View<value_type *, Kokkos::HostSpace>;
+    constexpr size_t _block = block_size / sizeof(value_type);
+
+    auto _buffer = buffer_t{
+        Kokkos::view_alloc(Kokkos::WithoutInitializing, "pykokkos_view_io"),
+        std::min<size_t>(_block, _flat.extent(0))};
+    for (size_t i = 0; i < _flat.extent(0); i += _block) {
+      auto _n      = std::min<size_t>(_block, _flat.extent(0) - i);
+      auto _range  = Kokkos::make_pair(i, i + _n);
+      auto _device = Kokkos::subview(_flat, _range);
+      auto _host   = Kokkos::subview(_buffer, Kokkos::make_pair(size_t{0}, _n));
+      auto _offset = data_offset + i * sizeof(value_type);
+      if (_write) {
+        Kokkos::deep_copy(_host, _device);
+        _file.write(_host.data(), _n * sizeof(value_type), _offset);
+      } else {
+        _file.read(_host.data(), _n * sizeof(value_type), _offset);
+        Kokkos::deep_copy(_device, _host);
+      }
+    }
+  }
+}
+
+template <typename ViewT>
+void save(ViewT &_view, const std::string &_path, bool _direct) {
+  using value_type = typename ViewT::non_const_value_type;
+  using layout     = typename ViewT::array_layout;
+
+  if (!_view.span_is_contiguous())
+    throw py::value_error("Error! Only contiguous views can be saved");
+
+  auto _header      = header{};
+  _header.dtype     = ViewDataTypeIndex<value_type>::value;
+  _header.layout    = MemoryLayoutIndex<layout>::value;
+  _header.rank      = _view.rank();
+  _header.dynamic   = Kokkos::is_dyn_rank_view<ViewT>::value;
+  _header.data_size = _view.span() * sizeof(value_type);
+  for (uint32_t i = 0; i < _header.rank; ++i)
+    _header.extents[i] = _view.extent(i);
+
+  file _file{_path, true, _direct};
+  _file.write_header(_header, _view.label());
+  transfer(_view, _file, true);
+}
+
+template <typename ViewT>
+void load(ViewT &_view, const std::string &_path, bool _direct) {
+  using value_type = typename ViewT::non_const_value_type;
+  using layout     = typename ViewT::array_layout;
+
+  if (!_view.span_is_contiguous())
+    throw py::value_error("Error! Only contiguous views can be loaded");
+
+  std::string _label{};
+  file _file{_path, false, _direct};
+  auto _header = _file.read_header(_label);
+
+  if (_header.dtype != ViewDataTypeIndex<value_type>::value ||
+      _header.layout != MemoryLayoutIndex<layout>::value ||
+      _header.rank != _view.rank())
+    throw py::value_error("Error! The data type, layout, or rank in '" +
+                          _path + "' does not match the view");
+  for (uint32_t i = 0; i < _header.rank; ++i) {
+    if (_header.extents[i] != _view.extent(i))
+      throw py::value_error("Error! The extent of dimension " +
+                            std::to_string(i) + " in '" + _path +
+                            "' does not match the view");
+  }
+  if (_header.data_size != _view.span() * sizeof(value_type))
+    throw py::value_error("Error! The data size in '" + _path +
+                          "' does not match the view");
+
+  transfer(_view, _file, false);
+}
+}  // namespace view_io
@@ -50,12 +50,15 @@
 #include <Kokkos_DynRankView.hpp>
 #include <iostream>
 
+#include "async.hpp"
 #include "common.hpp"
 #include "concepts.hpp"
 #include "deep_copy.hpp"
 #include "defines.hpp"
 #include "fwd.hpp"
 #include "traits.hpp"
+#include "view_cache.hpp"
+#include "view_io.hpp"
 
 //----------------------------------------------------------------------------//
 
@@ -209,9 +212,16 @@ struct get_item {
 namespace Impl {
 //
 template <typename ViewT, typename Up, size_t... Idx>
-auto get_init(const std::string &lbl, const Up &arr,
+auto get_init(const std::string &lbl, const Up &arr, bool initialize,
               std::index_sequence<Idx...>) {
-  return new ViewT{lbl, static_cast<size_t>(std::get<Idx>(arr))...};
+  return view_cache::allocate<ViewT>(
+      lbl, initialize, static_cast<size_t>(std::get<Idx>(arr))...);
+}
+//
+template <typename Tp, typename Up, size_t... Idx>
+auto construct_from_extents(const std::string &lbl, const Up &arr,
+                            std::index_sequence<Idx...>) {
+  return new Tp{lbl, static_cast<size_t>(std::get<Idx>(arr))...};
 }
 //
 template <typename ViewT, typename Up, typename Tp, size_t... Idx>
@@ -224,16 +234,25 @@ auto get_unmanaged_init(const Up &arr, const Tp data,
 
 template <typename ViewT, size_t Idx>
 auto get_init() {
-  return [](std::string lbl, std::array<size_t, Idx> arr) {
-    return Impl::get_init<ViewT>(lbl, arr, std::make_index_sequence<Idx>{});
+  return [](std::string lbl, std::array<size_t, Idx> arr, bool initialize) {
+    return Impl::get_init<ViewT>(lbl, arr, initialize,
+                                 std::make_index_sequence<Idx>{});
   };
 }
 
 template <typename ViewT, size_t Idx, typename Tp>
 auto get_unmanaged_init() {
   return [](py::buffer buf, std::array<size_t, Idx> arr) {
-    return Impl::get_unmanaged_init<ViewT>(arr,
-                                           static_cast<Tp *>(buf.request().ptr),
+    auto _info     = buf.request();
+    auto _required = sizeof(Tp);
+    for (auto itr : arr) _required *= itr;
+    auto _available = static_cast<size_t>(_info.size * _info.itemsize);
+    if (_available < _required)
+      throw py::value_error("Error! The buffer has " +
+                            std::to_string(_available) +
+                            " bytes but the view requires " +
+                            std::to_string(_required) + " bytes");
+    return Impl::get_unmanaged_init<ViewT>(arr, static_cast<Tp *>(_info.ptr),
                                            std::make_index_sequence<Idx>{});
   };
 }
@@ -242,18 +261,21 @@ template <typename ViewT, size_t Idx, typename Tp, typename Vp>
 auto get_init(
     Vp &_view,
     enable_if_t<!ViewT::traits::memory_traits::is_unmanaged, int> = 0) {
-  // define managed init
-  _view.def(py::init(get_init<ViewT, Idx>()));
-  // define unmanaged init
-  _view.def(py::init(get_unmanaged_init<ViewT, Idx, Tp>()));
+  // define managed init. initialize=False skips the zero-initialization
+  _view.def(py::init(get_init<ViewT, Idx>()), py::arg("label"),
+            py::arg("shape"), py::arg("initialize") = true);
+  // define unmanaged init. the view keeps the buffer alive
+  _view.def(py::init(get_unmanaged_init<ViewT, Idx, Tp>()),
+            py::keep_alive<1, 2>());
 }
 
 template <typename ViewT, size_t Idx, typename Tp, typename Vp>
 auto get_init(
     Vp &_view,
     enable_if_t<ViewT::traits::memory_traits::is_unmanaged, int> = 0) {
-  // define unmanaged init
-  _view.def(py::init(get_unmanaged_init<ViewT, Idx, Tp>()));
+  // define unmanaged init. the view keeps the buffer alive
+  _view.def(py::init(get_unmanaged_init<ViewT, Idx, Tp>()),
+            py::keep_alive<1, 2>());
 }
 
 //----------------------------------------------------------------------------//
@@ -321,13 +343,13 @@ void generate_view_access(py::class_<ViewT> &_view, std::index_sequence<Idx...>,
 template <typename ViewT, typename Sp, typename Tp, typename Lp, typename Mp,
           size_t DimIdx, size_t... Idx>
 void generate_view(py::module &_mod, const std::string &_name,
-                   const std::string &_msg, size_t _ndim = DimIdx + 1) {
+                   size_t _ndim = DimIdx + 1) {
   // some mirror views will instantiate types that were added already
   if (!add_pyclass<ViewT>()) return;
 
   if (debug_output())
-    std::cerr << "Registering " << _msg << " as python class '" << _name
-              << "'..." << std::endl;
+    std::cerr << "Registering " << demangle<ViewT>() << " as python class '"
+              << _name << "'..." << std::endl;
 
   // class decl
   py::class_<ViewT> _view(_mod, _name.c_str(), py::buffer_protocol());
@@ -355,6 +377,11 @@ void generate_view(py::module &_mod, const std::string &_name,
   using mirror_type = typename ViewT::host_mirror_type;
   using mirror_cast = kokkos_python_view_type_t<mirror_type>;
 
+  // with lazy registration, the classes returned from the methods below
+  // might not have been created yet
+  ensure_pyclass<mirror_cast>(_mod);
+  ensure_pyclass<decay_t<typename ViewT::reference_type>>(_mod);
+
   // if (!std::is_same<mirror_type, mirror_cast>::value) {
   //  py::implicitly_convertible<mirror_type, mirror_cast>();
   // }
@@ -378,7 +405,7 @@ void generate_view(py::module &_mod, const std::string &_name,
       },
       "Create a host mirror view (only creates new view if this is not on "
       "host)",
-      py::arg("copy") = true);
+      py::arg("copy") = true, py::keep_alive<0, 1>());
 
   using view_type_list_t =
       std::conditional_t<Kokkos::is_dyn_rank_view<ViewT>::value,
@@ -386,6 +413,71 @@ void generate_view(py::module &_mod, const std::string &_name,
 
   deep_copy<ViewT>{_view}(view_type_list_t{});
 
+  // asynchronous operations on an execution space instance
+  using exec_t = typename ViewT::execution_space;
+
+  _view.def(
+      "fill_async",
+      [](ViewT &_v, Tp _val, py::object _space) {
+        return fill_async(get_execution_space_instance<exec_t>(_space),
+                          Impl::get_flat_view(_v), _val);
+      },
+      "Assign a value to every element on an execution space instance and "
+      "return a Future",
+      py::arg("value"), py::arg("space") = py::none());
+
+  _view.def(
+      "sum_async",
+      [](ViewT &_v, py::object _space) {
+        return reduce_async<Kokkos::Sum>(
+            get_execution_space_instance<exec_t>(_space),
+            Impl::get_flat_view(_v));
+      },
+      "Sum of the elements. Returns a Future", py::arg("space") = py::none());
+
+  if constexpr (!is_complex<Tp>::value) {
+    _view.def(
+        "min_async",
+        [](ViewT &_v, py::object _space) {
+          return reduce_async<Kokkos::Min>(
+              get_execution_space_instance<exec_t>(_space),
+              Impl::get_flat_view(_v));
+        },
+        "Minimum of the elements. Returns a Future",
+        py::arg("space") = py::none());
+
+    _view.def(
+        "max_async",
+        [](ViewT &_v, py::object _space) {
+          return reduce_async<Kokkos::Max>(
+              get_execution_space_instance<exec_t>(_space),
+              Impl::get_flat_view(_v));
+        },
+        "Maximum of the elements. Returns a Future",
+        py::arg("space") = py::none());
+  }
+
+  // binary save/load (see kokkos.load)
+  _view.def(
+      "save",
+      [](ViewT &_v, const std::string &_path, bool _direct) {
+        py::gil_scoped_release _nogil{};
+        view_io::save(_v, _path, _direct);
+      },
+      "Write the data type, layout, extents, label, and data to a file. "
+      "direct=True uses O_DIRECT when the file system supports it",
+      py::arg("path"), py::arg("direct") = false);
+
+  _view.def(
+      "load",
+      [](ViewT &_v, const std::string &_path, bool _direct) {
+        py::gil_scoped_release _nogil{};
+        view_io::load(_v, _path, _direct);
+      },
+      "Read a file written by save with the same data type, layout, and "
+      "extents into this view",
+      py::arg("path"), py::arg("direct") = false);
+
   // shape property
   _view.def_property_readonly(
       "shape",
@@ -396,20 +488,20 @@ void generate_view(py::module &_mod, const std::string &_name,
 
   _view.def_property_readonly(
       "ndim",
-      [](ViewT &m) {
-        auto &&_extents =
-            get_extents(m, std::make_index_sequence<DimIdx + 1>{});
-        if (Kokkos::is_dyn_rank_view<ViewT>::value) {
-          size_t _ndim = 0;
-          for (auto &&itr : _extents) {
-            if (itr > 1) ++_ndim;
-          }
-          return _ndim;
-        }
-        return _extents.size();
+      [](ViewT &m) -> size_t {
+        // the runtime rank of a DynRankView, the extents of the unused ranks
+        // are one
+        if constexpr (Kokkos::is_dyn_rank_view<ViewT>::value)
+          return m.rank();
+        else
+          return DimIdx + 1;
       },
       "Get the number of allocated ranks of the array");
 
+  _view.def_property_readonly(
+      "dtype", [](ViewT &) { return ViewDataTypeIndex<Tp>::value; },
+      "Data type of the view");
+
   _view.def_property_readonly(
       "space", [](ViewT &) { return MemorySpaceIndex<Sp>::value; },
       "Memory space of the view (alias for 'memory_space')");
@@ -435,7 +527,7 @@ void generate_view(py::module &_mod, const std::string &_name,
       "Whether the rank is dynamic");
 
   _view.def_property_readonly(
-      "cpp_type", [=](ViewT &) { return _msg; },
+      "cpp_type", [](ViewT &) { return demangle<ViewT>(); },
       "Underlying C++ type as string");
 
   // support []
@@ -444,11 +536,9 @@ void generate_view(py::module &_mod, const std::string &_name,
 
 template <typename ViewT, typename Sp, typename Tp, typename Lp, typename Mp,
           size_t DimIdx, size_t... Idx>
-void generate_view(py::module &_mod, const std::string &_name,
-                   const std::string &_msg, size_t _ndim,
+void generate_view(py::module &_mod, const std::string &_name, size_t _ndim,
                    std::index_sequence<Idx...>) {
-  generate_view<ViewT, Sp, Tp, Lp, Mp, DimIdx, Idx...>(_mod, _name, _msg,
-                                                       _ndim);
+  generate_view<ViewT, Sp, Tp, Lp, Mp, DimIdx, Idx...>(_mod, _name, _ndim);
 }
 }  // namespace Common
 //
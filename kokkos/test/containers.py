@@ -0,0 +1,363 @@
+#!@PYTHON_EXECUTABLE@
+# ************************************************************************
+#
+#                        Kokkos v. 3.0
+#       Copyright (2020) National Technology & Engineering
+#               Solutions of Sandia, LLC (NTESS).
+#
+# Under the terms of Contract DE-NA0003525 with NTESS,
+# the U.S. Government retains certain rights in this software.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met:
+#
+# 1. Redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution.
+#
+# 3. Neither the name of the Corporation nor the names of the
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+# PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+# LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+# NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+# Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+#
+# ************************************************************************
+#
+
+from __future__ import absolute_import
+
+__author__ = "Jonathan R. Madsen"
+__copyright__ = (
+    "Copyright 2020, National Technology & Engineering Solutions of Sandia, LLC (NTESS)"
+)
+__credits__ = ["Kokkos"]
+__license__ = "BSD-3"
+__version__ = "@PROJECT_VERSION@"
+__maintainer__ = "Jonathan R. Madsen"
+__email__ = "jrmadsen@lbl.gov"
+__status__ = "Development"
+
+
+import kokkos
+import unittest
+
+
+class PyKokkosBaseContainersTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(self):
+        kokkos.initialize()
+
+    @classmethod
+    def tearDownClass(self):
+        if not kokkos.is_finalized():
+            kokkos.finalize()
+
+    def setUp(self):
+        pass
+
+    def tearDown(self):
+        pass
+
+    def test_dual_view(self):
+        """dual_view"""
+        _dual = kokkos.dual_view([4, 3], label="dual", dtype=kokkos.float64)
+        self.assertEqual(_dual.shape, [4, 3])
+        self.assertEqual(_dual.label, "dual")
+        self.assertEqual(_dual.dtype, kokkos.float64)
+
+        # modify on the host and read on the device
+        _host = _dual.view_host(modify=True)
+        _host[1, 2] = 3.0
+        _device = _dual.view_device()
+        self.assertFalse(_dual.need_sync_device())
+        self.assertEqual(_device.shape, [4, 3])
+
+        # the host view is up to date so no sync is needed
+        _host = _dual.view_host()
+        self.assertFalse(_dual.need_sync_host())
+        self.assertEqual(_host[1, 2], 3.0)
+
+        _dual.clear_sync_state()
+        self.assertFalse(_dual.need_sync_host())
+        self.assertFalse(_dual.need_sync_device())
+
+    def test_unordered_map(self):
+        """unordered_map"""
+        _map = kokkos.unordered_map(
+            kokkos.int64, kokkos.float64, space=kokkos.HostSpace, capacity=4
+        )
+        _keys = kokkos.array([6], dtype=kokkos.int64)
+        _values = kokkos.array([6], dtype=kokkos.float64)
+        for i, k in enumerate([3, 7, 3, 11, 19, 23]):
+            _keys[i] = k
+            _values[i] = 0.5 * i
+
+        # the table is rehashed if the capacity is exceeded
+        _counts = _map.insert(_keys, _values)
+        self.assertEqual(_counts, {"success": 5, "existing": 1, "failed": 0})
+        self.assertEqual(len(_map), 5)
+        self.assertGreaterEqual(_map.capacity, 5)
+
+        _lookup = kokkos.array([2], dtype=kokkos.int64)
+        _lookup[0] = 7
+        _lookup[1] = 8
+        _found_values, _found = _map.find(_lookup)
+        self.assertEqual(_found[0], 1)
+        self.assertEqual(_found[1], 0)
+        self.assertEqual(_found_values[0], 0.5)
+
+        self.assertEqual(_map.erase(_lookup), 1)
+        self.assertEqual(len(_map), 4)
+
+        _exported, _exported_values = _map.export()
+        self.assertEqual(sorted([_exported[i] for i in range(4)]), [3, 11, 19, 23])
+
+    def test_unordered_map_rehash(self):
+        """unordered_map rehash"""
+        # Kokkos rounds the capacity up (to at least 128) so insert more keys
+        # than that to overflow the table
+        _n = 1000
+        _map = kokkos.unordered_map(
+            kokkos.int64, kokkos.float64, space=kokkos.HostSpace, capacity=4
+        )
+        _initial = _map.capacity
+        _keys = kokkos.array([_n], dtype=kokkos.int64)
+        _values = kokkos.array([_n], dtype=kokkos.float64)
+        for i in range(_n):
+            _keys[i] = 7 * i
+            _values[i] = 1.0 * i
+        self.assertGreater(_n, _initial)
+
+        _counts = _map.insert(_keys, _values)
+        self.assertEqual(_counts["failed"], 0)
+        self.assertEqual(_counts["success"] + _counts["existing"], _n)
+        self.assertEqual(len(_map), _n)
+        self.assertGreater(_map.capacity, _initial)
+
+        # every key, including the ones inserted before the rehash, is found
+        _found_values, _found = _map.find(_keys)
+        self.assertEqual(sum(_found[i] for i in range(_n)), _n)
+        self.assertEqual(_found_values[_n - 1], 1.0 * (_n - 1))
+
+    def test_unordered_set(self):
+        """unordered_set"""
+        _set = kokkos.unordered_map(kokkos.int32, space=kokkos.HostSpace)
+        _keys = kokkos.array([8], dtype=kokkos.int32)
+        for i in range(8):
+            _keys[i] = i % 3
+
+        _counts = _set.insert(_keys)
+        self.assertEqual(_counts["success"], 3)
+        self.assertEqual(_counts["existing"], 5)
+        self.assertEqual(len(_set), 3)
+
+        _unique = _set.export()
+        self.assertEqual(sorted([_unique[i] for i in range(3)]), [0, 1, 2])
+        self.assertEqual(_set.contains(_keys)[7], 1)
+
+    def test_scatter_view(self):
+        """scatter_view"""
+        _target = kokkos.array([4], dtype=kokkos.float64)
+        _indices = kokkos.array([8], dtype=kokkos.int32)
+        _values = kokkos.array([8], dtype=kokkos.float64)
+        for i in range(8):
+            _indices[i] = i % 4
+            _values[i] = 1.0 + i
+
+        for _duplicated in (True, False):
+            _target.fill_async(0.0).wait()
+            _scatter = kokkos.scatter_view(_target, "sum", duplicated=_duplicated)
+            self.assertEqual(_scatter.duplicated, _duplicated)
+            self.assertEqual(_scatter.operation, "sum")
+            _scatter.scatter(_indices, _values)
+            _scatter.contribute_into(_target)
+            self.assertEqual([_target[i] for i in range(4)], [6.0, 8.0, 10.0, 12.0])
+
+        _target.fill_async(0.0).wait()
+        _scatter = kokkos.scatter_view(_target, "max")
+        _scatter.scatter(_indices, _values)
+        _scatter.contribute_into(_target)
+        self.assertEqual([_target[i] for i in range(4)], [5.0, 6.0, 7.0, 8.0])
+
+        # the indices are checked against the extent of the view
+        for _invalid in (4, -1):
+            _indices[3] = _invalid
+            with self.assertRaises(IndexError):
+                _scatter.scatter(_indices, _values)
+
+    def test_bitset(self):
+        """bitset"""
+        _bits = kokkos.bitset(10)
+        self.assertEqual(_bits.size(), 10)
+        self.assertEqual(_bits.count(), 0)
+
+        _indices = kokkos.array([3], dtype=kokkos.int32)
+        for i, _idx in enumerate([1, 4, 9]):
+            _indices[i] = _idx
+        _bits.set(_indices)
+        self.assertEqual(_bits.count(), 3)
+
+        _query = kokkos.array([4], dtype=kokkos.int64)
+        for i, _idx in enumerate([0, 1, 4, 5]):
+            _query[i] = _idx
+        _found = _bits.test(_query)
+        self.assertEqual([_found[i] for i in range(4)], [0, 1, 1, 0])
+
+        _mask = _bits.to_mask()
+        self.assertEqual(_mask.shape, [10])
+        self.assertEqual([i for i in range(10) if _mask[i]], [1, 4, 9])
+
+        _bits.reset(_indices)
+        self.assertEqual(_bits.count(), 0)
+        _bits.from_mask(_mask)
+        self.assertEqual(_bits.count(), 3)
+        _bits.set()
+        self.assertEqual(_bits.count(), 10)
+        _bits.reset()
+        self.assertEqual(_bits.count(), 0)
+
+    def test_tools_callbacks(self):
+        """tools callbacks"""
+        # the container kernels are launched with the GIL released so the
+        # python callbacks have to acquire it
+        _names = []
+
+        def _begin(name, devid):
+            _names.append(name)
+            return len(_names)
+
+        kokkos.tools.set_begin_parallel_for_callback(_begin)
+        try:
+            _map = kokkos.unordered_map(kokkos.int64, space=kokkos.HostSpace)
+            _keys = kokkos.array([4], dtype=kokkos.int64)
+            for i in range(4):
+                _keys[i] = i
+            self.assertEqual(_map.insert(_keys)["success"], 4)
+
+            _bits = kokkos.bitset(10)
+            _bits.set(_keys)
+            self.assertEqual(_bits.count(), 4)
+        finally:
+            kokkos.tools.set_begin_parallel_for_callback(None)
+        self.assertGreaterEqual(len(_names), 2)
+
+    def test_growable_array(self):
+        """growable_array"""
+        _growable = kokkos.growable_array(
+            dtype=kokkos.int64, space=kokkos.HostSpace, chunk_size=4, max_extent=64
+        )
+        self.assertEqual(len(_growable), 0)
+        for i in range(10):
+            _growable.append(i)
+        self.assertEqual(len(_growable), 10)
+        self.assertGreaterEqual(_growable.capacity(), 10)
+
+        _view = kokkos.array([5], dtype=kokkos.int64, space=kokkos.HostSpace)
+        for i in range(5):
+            _view[i] = 10 + i
+        _growable.extend(_view)
+        self.assertEqual([_growable[i] for i in range(15)], list(range(15)))
+
+        _contiguous = _growable.to_view()
+        self.assertEqual(_contiguous.shape, [15])
+        self.assertEqual([_contiguous[i] for i in range(15)], list(range(15)))
+
+        _growable.resize_serial(3)
+        self.assertEqual(len(_growable), 3)
+        with self.assertRaises(IndexError):
+            _growable[3]
+        with self.assertRaises(ValueError):
+            _growable.resize_serial(65)
+
+    def test_offset_view(self):
+        """offset_view"""
+        _view = kokkos.array([6], dtype=kokkos.float64, space=kokkos.HostSpace)
+        for i in range(6):
+            _view[i] = 1.0 * i
+
+        _offset = kokkos.offset_view(_view, [-1])
+        self.assertEqual(_offset.begins, [-1])
+        self.assertEqual(_offset.ends, [5])
+        self.assertEqual(_offset.shape, [6])
+        self.assertEqual(_offset[-1], 0.0)
+        self.assertEqual(_offset[4], 5.0)
+        with self.assertRaises(IndexError):
+            _offset[5]
+
+        # the storage is shared with the view
+        _offset[0] = 10.0
+        self.assertEqual(_view[1], 10.0)
+        self.assertEqual(_offset.view()[1], 10.0)
+
+        _matrix = kokkos.array([3, 4], dtype=kokkos.int32, space=kokkos.HostSpace)
+        _matrix[1, 2] = 7
+        _offset = kokkos.offset_view(_matrix, [-1, 2])
+        self.assertEqual(_offset.ndim, 2)
+        self.assertEqual(_offset[0, 4], 7)
+
+    def test_crs_matrix(self):
+        """crs_matrix"""
+
+        # [[1, 0, 2], [0, 3, 0], [4, 0, 5]]
+        def _array(data, dtype):
+            _view = kokkos.array([len(data)], dtype=dtype, space=kokkos.HostSpace)
+            for i, _val in enumerate(data):
+                _view[i] = _val
+            return _view
+
+        _row_map = _array([0, 2, 3, 5], kokkos.int32)
+        _entries = _array([0, 2, 1, 0, 2], kokkos.int32)
+        _values = _array([1.0, 2.0, 3.0, 4.0, 5.0], kokkos.float64)
+        _matrix = kokkos.crs_matrix(_row_map, _entries, _values, 3)
+        self.assertEqual(_matrix.shape, [3, 3])
+        self.assertEqual(_matrix.nnz, 5)
+
+        _x = _array([1.0, 1.0, 1.0], kokkos.float64)
+        _y = _matrix @ _x
+        self.assertEqual([_y[i] for i in range(3)], [3.0, 3.0, 9.0])
+
+        _matrix.spmv(_x, _y, transpose=True)
+        self.assertEqual([_y[i] for i in range(3)], [5.0, 3.0, 7.0])
+
+        _matrix.spmv(_x, _y, alpha=2.0, beta=1.0)
+        self.assertEqual([_y[i] for i in range(3)], [11.0, 9.0, 25.0])
+
+        with self.assertRaises(ValueError):
+            kokkos.crs_matrix(_row_map, _entries, _array([1.0], kokkos.float64), 3)
+        # decreasing row map offsets and out of range column indices
+        with self.assertRaises(ValueError):
+            kokkos.crs_matrix(_array([0, 3, 2, 5], kokkos.int32), _entries, _values, 3)
+        with self.assertRaises(ValueError):
+            kokkos.crs_matrix(
+                _row_map, _array([0, 2, 1, 0, 3], kokkos.int32), _values, 3
+            )
+        with self.assertRaises(ValueError):
+            kokkos.crs_matrix(
+                _row_map, _array([0, 2, -1, 0, 2], kokkos.int32), _values, 3
+            )
+
+
+# main runner
+def run():
+    # run all tests
+    unittest.main()
+
+
+if __name__ == "__main__":
+    run()
@@ -0,0 +1,202 @@
+#!@PYTHON_EXECUTABLE@
+# ************************************************************************
+#
+#                        Kokkos v. 3.0
+#       Copyright (2020) National Technology & Engineering
+#               Solutions of Sandia, LLC (NTESS).
+#
+# Under the terms of Contract DE-NA0003525 with NTESS,
+# the U.S. Government retains certain rights in this software.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met:
+#
+# 1. Redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution.
+#
+# 3. Neither the name of the Corporation nor the names of the
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+# PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+# LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+# NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+# Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+#
+# ************************************************************************
+#
+
+from __future__ import absolute_import
+
+__author__ = "Jonathan R. Madsen"
+__copyright__ = (
+    "Copyright 2020, National Technology & Engineering Solutions of Sandia, LLC (NTESS)"
+)
+__credits__ = ["Kokkos"]
+__license__ = "BSD-3"
+__version__ = "@PROJECT_VERSION@"
+__maintainer__ = "Jonathan R. Madsen"
+__email__ = "jrmadsen@lbl.gov"
+__status__ = "Development"
+
+
+import kokkos
+import unittest
+
+
+def _host_execution_space():
+    _name = kokkos.get_execution_space(kokkos.DefaultHostExecutionSpace)
+    return getattr(kokkos, f"KokkosExecutionSpace_{_name}")()
+
+
+class PyKokkosBaseFuturesTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(self):
+        kokkos.initialize()
+
+    @classmethod
+    def tearDownClass(self):
+        if not kokkos.is_finalized():
+            kokkos.finalize()
+
+    def setUp(self):
+        pass
+
+    def tearDown(self):
+        pass
+
+    def test_future_default(self):
+        """future_default"""
+
+        _future = kokkos.Future()
+        self.assertTrue(_future.done())
+        _future.wait()
+        self.assertIsNone(_future.result())
+
+    def test_future_fill(self):
+        """future_fill"""
+
+        _space = _host_execution_space()
+        for _dynamic in [False, True]:
+            _view = kokkos.array([4, 3], dtype=kokkos.double, dynamic=_dynamic)
+            _future = _view.fill_async(2.0, _space)
+            _future.wait()
+            self.assertTrue(_future.done())
+            self.assertIsNone(_future.result())
+            self.assertEqual(_view[3, 2], 2.0)
+
+    def test_future_deep_copy(self):
+        """future_deep_copy"""
+
+        _src = kokkos.array([10], dtype=kokkos.int32)
+        _dst = kokkos.array([10], dtype=kokkos.int32)
+        for i in range(10):
+            _src[i] = i
+        kokkos.deep_copy_async(_dst, _src).wait()
+        for i in range(10):
+            self.assertEqual(_dst[i], i)
+
+    def test_future_reductions(self):
+        """future_reductions"""
+
+        _space = _host_execution_space()
+        _view = kokkos.array([8], dtype=kokkos.int64)
+        for i in range(8):
+            _view[i] = i - 2
+        self.assertEqual(_view.sum_async(_space).result(), 20)
+        self.assertEqual(_view.min_async(_space).result(), -2)
+        self.assertEqual(_view.max_async().result(), 5)
+
+    def test_future_then(self):
+        """future_then"""
+
+        _view = kokkos.array([4], dtype=kokkos.float64)
+        _future = (
+            _view.fill_async(1.5)
+            .then(lambda _: _view.sum_async())
+            .then(lambda _sum: 2 * _sum)
+        )
+        self.assertEqual(_future.result(), 12.0)
+        # result is cached
+        self.assertEqual(_future.result(), 12.0)
+
+    def test_future_add_done_callback(self):
+        """future_add_done_callback"""
+
+        import threading
+
+        _event = threading.Event()
+        _results = []
+
+        def _callback(_f):
+            _results.append(_f.result())
+            _event.set()
+
+        _view = kokkos.array([16], dtype=kokkos.float32)
+        _future = _view.fill_async(3.0).then(lambda _: _view.sum_async())
+        _future.add_done_callback(_callback)
+
+        self.assertTrue(_event.wait(timeout=60))
+        self.assertEqual(_results, [48.0])
+
+    def test_future_await(self):
+        """future_await"""
+
+        import asyncio
+
+        async def _main():
+            _space = _host_execution_space()
+            _view = kokkos.array([16], dtype=kokkos.int32)
+            self.assertIsNone(await _view.fill_async(2, _space))
+            await _space.fence_async()
+            return await _view.sum_async(_space)
+
+        self.assertEqual(asyncio.run(_main()), 32)
+
+    def test_future_then_await(self):
+        """future_then_await"""
+
+        import asyncio
+
+        async def _main():
+            _view = kokkos.array([4], dtype=kokkos.float64)
+            return await _view.fill_async(2.0).then(lambda _: _view.sum_async())
+
+        self.assertEqual(asyncio.run(_main()), 8.0)
+
+    def test_future_then_exception(self):
+        """future_then_exception"""
+
+        def _raise(_):
+            raise KeyError("then")
+
+        _future = kokkos.Future().then(_raise)
+        with self.assertRaises(KeyError):
+            _future.result()
+        # the dependent futures see the exception as well
+        with self.assertRaises(KeyError):
+            _future.then(lambda _: None).result()
+
+
+# main runner
+def run():
+    # run all tests
+    unittest.main()
+
+
+if __name__ == "__main__":
+    run()
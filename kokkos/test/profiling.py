@@ -0,0 +1,409 @@
+#!@PYTHON_EXECUTABLE@
+# ************************************************************************
+#
+#                        Kokkos v. 3.0
+#       Copyright (2020) National Technology & Engineering
+#               Solutions of Sandia, LLC (NTESS).
+#
+# Under the terms of Contract DE-NA0003525 with NTESS,
+# the U.S. Government retains certain rights in this software.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met:
+#
+# 1. Redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution.
+#
+# 3. Neither the name of the Corporation nor the names of the
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+# PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+# LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+# NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+# Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+#
+# ************************************************************************
+#
+
+from __future__ import absolute_import
+
+__author__ = "Jonathan R. Madsen"
+__copyright__ = (
+    "Copyright 2020, National Technology & Engineering Solutions of Sandia, LLC (NTESS)"
+)
+__credits__ = ["Kokkos"]
+__license__ = "BSD-3"
+__version__ = "@PROJECT_VERSION@"
+__maintainer__ = "Jonathan R. Madsen"
+__email__ = "jrmadsen@lbl.gov"
+__status__ = "Development"
+
+
+import json
+import kokkos
+import unittest
+
+
+class PyKokkosBaseProfilingTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(self):
+        kokkos.initialize()
+
+    @classmethod
+    def tearDownClass(self):
+        if not kokkos.is_finalized():
+            kokkos.finalize()
+
+    def setUp(self):
+        pass
+
+    def tearDown(self):
+        pass
+
+    def test_memory_tracker(self):
+        """memory_tracker"""
+
+        _tracker = kokkos.tools.memory_tracker
+        _tracker.install()
+        try:
+            self.assertTrue(_tracker.installed())
+
+            _view = kokkos.array("tracked_view", [128], dtype=kokkos.float64)
+            _snapshot = _tracker.snapshot()
+            _label = _snapshot["labels"]["tracked_view"]
+            self.assertEqual(_label["current"], 128 * 8)
+            self.assertEqual(_label["peak"], 128 * 8)
+            self.assertEqual(_label["allocations"], 1)
+            self.assertGreaterEqual(_snapshot["spaces"]["Host"]["peak"], 128 * 8)
+
+            del _view
+            _label = _tracker.snapshot()["labels"]["tracked_view"]
+            self.assertEqual(_label["current"], 0)
+            self.assertEqual(_label["peak"], 128 * 8)
+            self.assertEqual(_label["deallocations"], 1)
+
+            _tracker.reset_peak()
+            _label = _tracker.snapshot()["labels"]["tracked_view"]
+            self.assertEqual(_label["peak"], 0)
+        finally:
+            _tracker.uninstall()
+        self.assertFalse(_tracker.installed())
+
+    def test_event_recorder(self):
+        """event recorder"""
+
+        _recorder = kokkos.tools.recorder
+        _recorder.enable(capacity=1024)
+        try:
+            self.assertTrue(_recorder.enabled())
+            _recorder.clear()
+
+            kokkos.tools.push_region("recorded_region")
+            kokkos.tools.mark_event("recorded_mark")
+            _src = kokkos.array("recorded_src", [64], dtype=kokkos.float64)
+            _dst = kokkos.array("recorded_dst", [64], dtype=kokkos.float64)
+            kokkos.deep_copy(_dst, _src)
+            kokkos.tools.pop_region()
+
+            _events = _recorder.drain()
+            _names = _recorder.names()
+            self.assertEqual(_names[0], "")
+            self.assertEqual(_recorder.dropped(), 0)
+
+            def _find(_kind, _name):
+                return [
+                    _event
+                    for _event in _events
+                    if _event["kind"] == int(_kind)
+                    and _names[_event["name"]] == _name
+                ]
+
+            _region = _find(kokkos.tools.recorder.Region, "recorded_region")
+            self.assertEqual(len(_region), 1)
+            self.assertEqual(
+                len(_find(kokkos.tools.recorder.Mark, "recorded_mark")), 1
+            )
+            _alloc = _find(kokkos.tools.recorder.Allocate, "recorded_src")
+            self.assertEqual(len(_alloc), 1)
+            self.assertEqual(_alloc[0]["size"], 64 * 8)
+            self.assertEqual(_names[_alloc[0]["space"]], "Host")
+
+            _copy = [
+                _event
+                for _event in _events
+                if _event["kind"] == int(kokkos.tools.recorder.DeepCopy)
+                and _names[_event["source"]] == "recorded_src"
+            ]
+            self.assertEqual(len(_copy), 1)
+            self.assertEqual(_names[_copy[0]["name"]], "recorded_dst")
+            self.assertEqual(_copy[0]["size"], 64 * 8)
+
+            # the region encloses the events recorded within it
+            _begin = _region[0]["timestamp"]
+            _end = _begin + _region[0]["duration"]
+            self.assertGreaterEqual(_copy[0]["timestamp"], _begin)
+            self.assertLessEqual(_copy[0]["timestamp"], _end)
+
+            # drained events are released
+            self.assertEqual(len(_recorder.drain()), 0)
+        finally:
+            _recorder.disable()
+        self.assertFalse(_recorder.enabled())
+
+    def test_chrome_trace(self):
+        """chrome trace"""
+
+        _trace = kokkos.tools.chrome_trace
+        _trace.clear()
+        _trace.start()
+        try:
+            self.assertTrue(_trace.running())
+            kokkos.tools.push_region("outer_region")
+            kokkos.tools.push_region("inner_region")
+            _src = kokkos.array("traced_src", [32], dtype=kokkos.float64)
+            _dst = kokkos.array("traced_dst", [32], dtype=kokkos.float64)
+            kokkos.deep_copy(_dst, _src)
+            kokkos.tools.pop_region()
+            kokkos.tools.pop_region()
+        finally:
+            _trace.stop()
+        self.assertFalse(_trace.running())
+
+        _events = json.loads(_trace.dumps())["traceEvents"]
+        _regions = dict(
+            (_event["name"], _event)
+            for _event in _events
+            if _event.get("cat") == "region"
+        )
+        _outer = _regions["outer_region"]
+        _inner = _regions["inner_region"]
+        self.assertEqual(_outer["ph"], "X")
+        self.assertEqual(_outer["tid"], _inner["tid"])
+        self.assertLessEqual(_outer["ts"], _inner["ts"])
+        self.assertGreaterEqual(
+            _outer["ts"] + _outer["dur"], _inner["ts"] + _inner["dur"]
+        )
+
+        _copies = [
+            _event
+            for _event in _events
+            if _event.get("cat") == "deep_copy" and _event["ph"] == "X"
+        ]
+        self.assertEqual(len(_copies), 2)
+        self.assertEqual(_copies[0]["args"]["bytes"], 32 * 8)
+        self.assertEqual(_copies[0]["args"]["src"], "traced_src")
+        _flows = [_event["ph"] for _event in _events if _event["ph"] in "sf"]
+        self.assertEqual(sorted(_flows), ["f", "s"])
+
+        _trace.clear()
+        _events = json.loads(_trace.dumps())["traceEvents"]
+        self.assertEqual([_e for _e in _events if _e["ph"] != "M"], [])
+
+        # freeing an allocation made before the trace started does not drive
+        # the memory counter negative
+        _view = kokkos.array("untraced", [64], dtype=kokkos.float64)
+        _trace.start()
+        try:
+            del _view
+        finally:
+            _trace.stop()
+        _events = json.loads(_trace.dumps())["traceEvents"]
+        _counters = [_e["args"]["bytes"] for _e in _events if _e["ph"] == "C"]
+        self.assertTrue(all(_value >= 0 for _value in _counters))
+        _trace.clear()
+
+        # the regions opened before the trace started are not closed by the
+        # regions popped while it runs
+        kokkos.tools.push_region("untraced_region")
+        _trace.start()
+        try:
+            kokkos.tools.push_region("traced_region")
+            kokkos.tools.pop_region()
+            kokkos.tools.pop_region()
+        finally:
+            _trace.stop()
+        _events = json.loads(_trace.dumps())["traceEvents"]
+        _names = [_e["name"] for _e in _events if _e.get("cat") == "region"]
+        self.assertEqual(_names, ["traced_region"])
+        _trace.clear()
+
+    def test_kernel_timer(self):
+        """kernel timer"""
+
+        _timer = kokkos.tools.kernel_timer
+        _timer.install()
+        try:
+            self.assertTrue(_timer.installed())
+            for _ in range(3):
+                kokkos.tools.push_region("timed_region")
+                kokkos.tools.pop_region()
+            kokkos.tools.push_region("timed_once")
+            kokkos.tools.pop_region()
+        finally:
+            _timer.uninstall()
+        self.assertFalse(_timer.installed())
+
+        _results = dict((_row["name"], _row) for _row in _timer.results())
+        _region = _results["timed_region"]
+        self.assertEqual(_region["type"], "region")
+        self.assertEqual(_region["count"], 3)
+        self.assertLessEqual(_region["min"], _region["mean"])
+        self.assertLessEqual(_region["mean"], _region["max"])
+        self.assertAlmostEqual(_region["mean"] * 3, _region["total"])
+        self.assertEqual(_results["timed_once"]["count"], 1)
+
+        _counts = [_row["count"] for _row in _timer.results(sort="count")]
+        self.assertEqual(_counts, sorted(_counts, reverse=True))
+        self.assertIn("timed_region", _timer.report())
+        with self.assertRaises(ValueError):
+            _timer.results(sort="unknown")
+
+        _timer.reset()
+        self.assertEqual(_timer.results(), [])
+
+    def test_perf_counters(self):
+        """perf counters"""
+
+        _perf = kokkos.tools.perf_counters
+        if not _perf.available():
+            self.skipTest("perf_event_open is not available")
+        try:
+            _perf.install()
+        except RuntimeError as e:
+            self.skipTest("{}".format(e))
+
+        try:
+            self.assertTrue(_perf.installed())
+            _view = kokkos.array("counted", [1000], dtype=kokkos.float64)
+            _view.fill_async(1.0).wait()
+            for _ in range(2):
+                self.assertEqual(_view.sum_async().result(), 1000)
+        finally:
+            _perf.uninstall()
+        self.assertFalse(_perf.installed())
+
+        _kernel = _perf.results()["pykokkos_reduce_async"]
+        self.assertEqual(_kernel["count"], 2)
+        for _event in _perf.events():
+            self.assertIn(_event, _kernel)
+
+        _perf.reset()
+        self.assertEqual(_perf.results(), {})
+
+    def test_transfer_ledger(self):
+        """transfer ledger"""
+
+        _ledger = kokkos.tools.transfer_ledger
+        _ledger.install()
+        try:
+            self.assertTrue(_ledger.installed())
+            _src = kokkos.array("ledger_src", [256], dtype=kokkos.float64)
+            _dst = kokkos.array("ledger_dst", [256], dtype=kokkos.float64)
+            _small = kokkos.array("ledger_small", [2], dtype=kokkos.float64)
+            for _ in range(3):
+                kokkos.deep_copy(_dst, _src)
+            kokkos.deep_copy(_small, kokkos.array("tmp", [2], dtype=kokkos.float64))
+        finally:
+            _ledger.uninstall()
+        self.assertFalse(_ledger.installed())
+
+        _results = dict((_row["label"], _row) for _row in _ledger.results())
+        _dst = _results["ledger_dst"]
+        self.assertEqual(_dst["src_space"], "Host")
+        self.assertEqual(_dst["dst_space"], "Host")
+        self.assertEqual(_dst["count"], 3)
+        self.assertEqual(_dst["bytes"], 3 * 256 * 8)
+        self.assertEqual(_dst["min_bytes"], 256 * 8)
+        self.assertGreaterEqual(_dst["bandwidth"], 0.0)
+        # the blocking deep copies are fenced before they return
+        self.assertEqual(_dst["fenced"], 3)
+        self.assertGreaterEqual(_dst["enqueue_seconds"], 0.0)
+        self.assertEqual(_results["ledger_small"]["bytes"], 2 * 8)
+
+        _bins = _ledger.histograms()[("Host", "Host")]
+        _counts = dict((_bin["lower"], _bin["count"]) for _bin in _bins)
+        self.assertEqual(_counts[2048], 3)
+        self.assertEqual(_counts[16], 1)
+        for _bin in _bins:
+            self.assertLessEqual(_bin["lower"], _bin["min_bytes"])
+            self.assertLess(_bin["max_bytes"], _bin["upper"])
+
+        _ledger.reset()
+        self.assertEqual(_ledger.results(), [])
+
+    def test_tuning(self):
+        """tuning"""
+
+        _tuning = kokkos.tools.tuning
+        _int64 = _tuning.value_type.int64
+        _ordinal = _tuning.statistical_category.ordinal
+
+        _candidates = [1, 2, 4, 8]
+        _size = _tuning.declare_input_type("test_size", _int64)
+        _team = _tuning.declare_output_type(
+            "test_team", _int64, _ordinal, candidates=_candidates
+        )
+        _tile = _tuning.declare_output_type(
+            "test_tile",
+            _int64,
+            _ordinal,
+            candidates=_tuning.candidate_range(10, 30, 10, open_upper=True),
+        )
+
+        _strategies = [
+            _tuning.search_strategy.grid,
+            _tuning.search_strategy.random,
+            _tuning.search_strategy.bandit,
+        ]
+        for _strategy in _strategies:
+            _tuning.install(strategy=_strategy, samples=8, seed=1)
+            self.assertTrue(_tuning.installed())
+            try:
+                for _ in range(12):
+                    _ctx = _tuning.get_new_context_id()
+                    _tuning.begin_context(_ctx)
+                    _tuning.set_input_values(_ctx, {_size: 100})
+                    _values = _tuning.request_output_values(
+                        _ctx, {_team: 1, _tile: 10}
+                    )
+                    self.assertIn(_values[_team], _candidates)
+                    self.assertIn(_values[_tile], [10, 20])
+                    _tuning.end_context(_ctx)
+            finally:
+                _tuning.uninstall()
+            self.assertFalse(_tuning.installed())
+
+            if not _tuning.tuning_enabled():
+                continue
+            _results = _tuning.results()
+            self.assertEqual(len(_results), 1)
+            self.assertEqual(_results[0]["trials"], 12)
+            self.assertIn(_results[0]["best"]["test_team"], _candidates)
+            self.assertIn(_results[0]["best"]["test_tile"], [10, 20])
+            _counts = [_c["count"] for _c in _results[0]["configurations"]]
+            self.assertEqual(sum(_counts), 12)
+
+
+# main runner
+def run():
+    # run all tests
+    unittest.main()
+
+
+if __name__ == "__main__":
+    run()
@@ -55,6 +55,7 @@ __status__ = "Development"
 
 
 import kokkos
+import threading
 import unittest
 
 
@@ -319,6 +320,116 @@ class PyKokkosBaseToolsTests(unittest.TestCase):
         """python_declare_metadata"""
         kokkos.tools.declare_metadata("dogs", "good")
 
+    def test_region_context(self):
+        """python_region_context"""
+        _region = kokkos.tools.Region("python_region_context")
+        self.assertEqual(_region.name, "python_region_context")
+        for _ in range(3):
+            with _region:
+                self.assertEqual(data["python_region_context"], [True, False])
+            self.assertEqual(data["python_region_context"], [True, True])
+
+        @kokkos.tools.Region("python_region_decorator")
+        def _decorated(a, b=1):
+            """decorated function"""
+            self.assertEqual(data["python_region_decorator"], [True, False])
+            return a + b
+
+        self.assertEqual(_decorated(1, b=2), 3)
+        self.assertEqual(_decorated.__name__, "_decorated")
+        self.assertEqual(_decorated.__doc__, "decorated function")
+        self.assertEqual(data["python_region_decorator"], [True, True])
+
+        class _Object(object):
+            @kokkos.tools.Region("python_region_method")
+            def method(self, value):
+                return value * 2
+
+        self.assertEqual(_Object().method(2), 4)
+        self.assertEqual(data["python_region_method"], [True, True])
+
+    def test_profile_section_context(self):
+        """python_profile_section_context"""
+        _section = kokkos.tools.ProfileSection("python_section_context")
+        self.assertEqual(data["create_python_section_context"], _section.id)
+        with _section:
+            self.assertEqual(data["start_python_section_context"], _section.id)
+        self.assertEqual(data["stop_python_section_context"], _section.id)
+
+        with self.assertRaises(RuntimeError):
+            with _section:
+                raise RuntimeError("propagated")
+
+        @kokkos.tools.ProfileSection("python_section_decorator")
+        def _decorated():
+            return True
+
+        self.assertTrue(_decorated())
+        self.assertIn("stop_python_section_decorator", data)
+
+    def test_sampling(self):
+        """python_sampling"""
+        _counts = {"begin": 0, "end": 0, "push": 0, "pop": 0}
+
+        def _begin(name, devid):
+            _counts["begin"] += 1
+            return _counts["begin"]
+
+        def _end(kernid):
+            _counts["end"] += 1
+
+        def _push(name):
+            _counts["push"] += 1
+
+        def _pop():
+            _counts["pop"] += 1
+
+        _view = kokkos.array("sampled", [10], space=kokkos.Host, dtype=kokkos.int64)
+        kokkos.tools.set_begin_parallel_reduce_callback(_begin)
+        kokkos.tools.set_end_parallel_reduce_callback(_end)
+        kokkos.tools.set_push_region_callback(_push)
+        kokkos.tools.set_pop_region_callback(_pop)
+        try:
+            # every 3rd launch of the kernel name
+            kokkos.tools.set_sampling(every=3)
+            self.assertEqual(kokkos.tools.get_sampling()["every"], 3)
+            for _ in range(6):
+                _view.sum_async().result()
+            self.assertEqual(_counts["begin"], 2)
+            self.assertEqual(_counts["end"], 2)
+
+            # the continuation and the fences run on the future waiter thread
+            kokkos.tools.set_sampling(every=1)
+            _event = threading.Event()
+            _future = _view.fill_async(1).then(lambda _: _view.sum_async())
+            _future.add_done_callback(lambda _: _event.set())
+            self.assertTrue(_event.wait(timeout=60))
+            self.assertEqual(_future.result(), 10)
+            self.assertEqual(_counts["begin"], 3)
+            self.assertEqual(_counts["end"], 3)
+
+            # the first region uses up the budget of the current second
+            kokkos.tools.set_sampling(budget=1.0e-9)
+            for _ in range(5):
+                kokkos.tools.push_region("sampled_region")
+                kokkos.tools.pop_region()
+            self.assertEqual(_counts["push"], 1)
+            self.assertEqual(_counts["pop"], 1)
+            self.assertGreater(kokkos.tools.get_sampling()["skipped"], 0)
+
+            with self.assertRaises(ValueError):
+                kokkos.tools.set_sampling(every=0)
+        finally:
+            kokkos.tools.set_sampling()
+            kokkos.tools.set_begin_parallel_reduce_callback(None)
+            kokkos.tools.set_end_parallel_reduce_callback(None)
+            kokkos.tools.set_push_region_callback(push_region)
+            kokkos.tools.set_pop_region_callback(pop_region)
+
+        _sampling = kokkos.tools.get_sampling()
+        self.assertEqual(_sampling["every"], 1)
+        self.assertIsNone(_sampling["budget"])
+
 
 # main runner
 def run():
@@ -0,0 +1,166 @@
+#!@PYTHON_EXECUTABLE@
+# ************************************************************************
+#
+#                        Kokkos v. 3.0
+#       Copyright (2020) National Technology & Engineering
+#               Solutions of Sandia, LLC (NTESS).
+#
+# Under the terms of Contract DE-NA0003525 with NTESS,
+# the U.S. Government retains certain rights in this software.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met:
+#
+# 1. Redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution.
+#
+# 3. Neither the name of the Corporation nor the names of the
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+# PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+# LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+# NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+# Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+#
+# ************************************************************************
+#
+
+from __future__ import absolute_import
+
+__author__ = "Jonathan R. Madsen"
+__copyright__ = (
+    "Copyright 2020, National Technology & Engineering Solutions of Sandia, LLC (NTESS)"
+)
+__credits__ = ["Kokkos"]
+__license__ = "BSD-3"
+__version__ = "@PROJECT_VERSION@"
+__maintainer__ = "Jonathan R. Madsen"
+__email__ = "jrmadsen@lbl.gov"
+__status__ = "Development"
+
+
+import kokkos
+import os
+import struct
+import tempfile
+import unittest
+
+
+class PyKokkosBaseViewIOTests(unittest.TestCase):
+    @classmethod
+    def setUpClass(self):
+        kokkos.initialize()
+
+    @classmethod
+    def tearDownClass(self):
+        if not kokkos.is_finalized():
+            kokkos.finalize()
+
+    def setUp(self):
+        pass
+
+    def tearDown(self):
+        pass
+
+    def test_view_save_load(self):
+        """save/load"""
+        _view = kokkos.array("saved", [3, 5], dtype=kokkos.float32)
+        for i in range(3):
+            for j in range(5):
+                _view[i, j] = 10.0 * i + j
+
+        with tempfile.TemporaryDirectory() as _dir:
+            _path = os.path.join(_dir, "view.bin")
+            _view.save(_path)
+
+            _header = kokkos.read_view_header(_path)
+            self.assertEqual(_header["dtype"], kokkos.float32)
+            self.assertEqual(_header["layout"], kokkos.LayoutRight)
+            self.assertEqual(_header["shape"], [3, 5])
+            self.assertEqual(_header["label"], "saved")
+            self.assertFalse(_header["dynamic"])
+
+            for _direct in (False, True):
+                _loaded = kokkos.load(_path, direct=_direct)
+                self.assertEqual(_loaded.shape, [3, 5])
+                self.assertEqual(_loaded.dtype, kokkos.float32)
+                for i in range(3):
+                    for j in range(5):
+                        self.assertEqual(_loaded[i, j], 10.0 * i + j)
+
+            # the data type and the extents have to match the view
+            with self.assertRaises(ValueError):
+                kokkos.array([3, 5], dtype=kokkos.float64).load(_path)
+            with self.assertRaises(ValueError):
+                kokkos.array([5, 3], dtype=kokkos.float32).load(_path)
+
+    def test_view_save_load_direct(self):
+        """save/load with O_DIRECT"""
+        # large enough for aligned blocks plus a remainder
+        _n = 3000
+        _view = kokkos.array([_n], dtype=kokkos.int64)
+        for i in range(_n):
+            _view[i] = i * i
+
+        with tempfile.TemporaryDirectory() as _dir:
+            _path = os.path.join(_dir, "view.bin")
+            _view.save(_path, direct=True)
+            _loaded = kokkos.load(_path, direct=True, label="loaded")
+            self.assertEqual(_loaded.shape, [_n])
+            self.assertEqual(
+                [_loaded[i] for i in range(_n)], [i * i for i in range(_n)]
+            )
+
+        with self.assertRaises(ValueError):
+            with tempfile.NamedTemporaryFile() as _f:
+                _f.write(b"not a view" * 100)
+                _f.flush()
+                kokkos.load(_f.name)
+
+    def test_view_load_invalid_header(self):
+        """load with an invalid header"""
+        _view = kokkos.array("saved", [4], dtype=kokkos.float64)
+        with tempfile.TemporaryDirectory() as _dir:
+            _path = os.path.join(_dir, "view.bin")
+            _view.save(_path)
+            with open(_path, "rb") as _f:
+                _data = bytearray(_f.read())
+
+            # each invalid field is reported on its own: the rank is at byte
+            # 20, the label size at byte 28, and the data size at byte 96
+            for _offset, _fmt, _value, _msg in (
+                (20, "I", 9, "rank"),
+                (28, "I", 1 << 20, "label size"),
+                (96, "Q", 4 * 8 + 1, "data size"),
+            ):
+                _corrupt = bytearray(_data)
+                struct.pack_into(_fmt, _corrupt, _offset, _value)
+                with open(_path, "wb") as _f:
+                    _f.write(_corrupt)
+                with self.assertRaisesRegex(ValueError, _msg):
+                    kokkos.read_view_header(_path)
+
+
+# main runner
+def run():
+    # run all tests
+    unittest.main()
+
+
+if __name__ == "__main__":
+    run()
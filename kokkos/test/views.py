@@ -55,6 +55,9 @@ __status__ = "Development"
 
 
 import kokkos
+import os
+import struct
+import tempfile
 import unittest
 
 try:
@@ -386,6 +389,197 @@ class PyKokkosBaseViewsTests(unittest.TestCase):
             self.assertEqual(_copied_data[0].create_mirror_view()[_idx], 3)
             self.assertEqual(_copied_data[1].create_mirror_view()[_idx], 6)
 
+    #
+    def test_view_uninitialized(self):
+        """view_uninitialized"""
+
+        for _dynamic in [False, True]:
+            _view = kokkos.array(
+                [4, 3], dtype=kokkos.float32, dynamic=_dynamic, initialize=False
+            )
+            self.assertEqual(_view.dtype, kokkos.float32)
+            _view[3, 2] = 2.0
+            self.assertEqual(_view[3, 2], 2.0)
+
+            _like = kokkos.empty_like(_view)
+            self.assertEqual(_like.dtype, _view.dtype)
+            self.assertEqual(_like.space, _view.space)
+            self.assertEqual(_like.layout, _view.layout)
+            self.assertEqual(_like.dynamic, _view.dynamic)
+            self.assertEqual(_like.shape, _view.shape)
+            self.assertEqual(type(_like), type(_view))
+
+        # trailing extents of one are kept
+        for _dynamic in [False, True]:
+            _view = kokkos.array([4, 1], dtype=kokkos.float32, dynamic=_dynamic)
+            self.assertEqual(_view.ndim, 2)
+            _like = kokkos.empty_like(_view)
+            self.assertEqual(_like.ndim, 2)
+            self.assertEqual(_like.shape, _view.shape)
+            self.assertEqual(type(_like), type(_view))
+
+    #
+    def test_view_caching_allocator(self):
+        """view_caching_allocator"""
+
+        _name = kokkos.get_memory_space(kokkos.HostSpace)
+        kokkos.allocator.enable()
+        try:
+            self.assertTrue(kokkos.allocator.enabled())
+            kokkos.allocator.trim()
+            _base = kokkos.allocator.statistics().get(_name, {"hits": 0})
+
+            _view = kokkos.array([64], dtype=kokkos.float64)
+            _view[3] = 1.0
+            del _view
+
+            # same type and extents is served from the cache and zero-filled
+            _view = kokkos.array([64], dtype=kokkos.float64)
+            self.assertEqual(_view[3], 0.0)
+
+            _stats = kokkos.allocator.statistics()[_name]
+            self.assertEqual(_stats["hits"] - _base["hits"], 1)
+            self.assertEqual(_stats["in_use"], 64 * 8)
+            self.assertEqual(_stats["cached"], 0)
+            self.assertGreaterEqual(_stats["high_water_mark"], 64 * 8)
+
+            # in use allocations are not released
+            self.assertEqual(kokkos.allocator.trim(kokkos.HostSpace), 0)
+            del _view
+            self.assertEqual(kokkos.allocator.statistics()[_name]["cached"], 64 * 8)
+            self.assertEqual(kokkos.allocator.trim(kokkos.HostSpace), 64 * 8)
+
+            # a shorter one-dimensional view is served from a larger allocation
+            _view = kokkos.array([64], dtype=kokkos.float64)
+            _view[40] = 1.0
+            del _view
+            _hits = kokkos.allocator.statistics()[_name]["hits"]
+            _view = kokkos.array([48], dtype=kokkos.float64)
+            self.assertEqual(_view.shape, [48])
+            self.assertEqual(_view[40], 0.0)
+            self.assertEqual(kokkos.allocator.statistics()[_name]["hits"], _hits + 1)
+            del _view
+
+            # free allocations beyond the limit are released
+            _limit = kokkos.allocator.get_limit()
+            try:
+                kokkos.allocator.set_limit(0)
+                self.assertEqual(kokkos.allocator.get_limit(), 0)
+                self.assertEqual(kokkos.allocator.statistics()[_name]["cached"], 0)
+                _view = kokkos.array([64], dtype=kokkos.float64)
+                del _view
+                _view = kokkos.array([16], dtype=kokkos.float64)
+                self.assertEqual(kokkos.allocator.statistics()[_name]["cached"], 0)
+            finally:
+                kokkos.allocator.set_limit(_limit)
+        finally:
+            kokkos.allocator.enable(False)
+        self.assertFalse(kokkos.allocator.enabled())
+
+    def test_view_make_view(self):
+        """view_make_view"""
+        _view = kokkos.make_view(
+            kokkos.float64, kokkos.HostSpace, kokkos.LayoutRight, None, 2, [3, 4]
+        )
+        _ref = kokkos.array([3, 4], dtype=kokkos.float64)
+        self.assertEqual(type(_view), type(_ref))
+        self.assertEqual(_view.shape, [3, 4])
+        self.assertEqual(_view.dtype, kokkos.float64)
+        self.assertEqual(_view[2, 3], 0.0)
+        # demangled on first access
+        self.assertEqual(_view.cpp_type, _ref.cpp_type)
+        self.assertGreater(len(_view.cpp_type), 0)
+
+        _dyn = kokkos.make_view(
+            kokkos.int32,
+            kokkos.HostSpace,
+            kokkos.LayoutRight,
+            kokkos.Managed,
+            2,
+            [5, 2],
+            label="dyn",
+            dynamic=True,
+        )
+        self.assertTrue(_dyn.dynamic)
+        self.assertEqual(_dyn.shape[:2], [5, 2])
+
+        # the rank must match the number of extents
+        with self.assertRaises(ValueError):
+            kokkos.make_view(
+                kokkos.float64, kokkos.HostSpace, kokkos.LayoutRight, None, 3, [3]
+            )
+
+    def test_view_lazy_registration(self):
+        """view_lazy_registration"""
+        _deferred = kokkos.get_deferred_names()
+        if not kokkos.lazy_registration():
+            self.assertEqual(len(_deferred), 0)
+
+        # a deferred class is created on first access through the package
+        for _name in _deferred[:2]:
+            self.assertIsNotNone(getattr(kokkos, _name))
+            self.assertNotIn(_name, kokkos.get_deferred_names())
+
+        with self.assertRaises(AttributeError):
+            getattr(kokkos, "KokkosView_does_not_exist")
+
+        _view = kokkos.array([4], dtype=kokkos.float64)
+        _mirror = _view.create_mirror_view()
+        self.assertEqual(_mirror.shape, [4])
+
+        kokkos.register_all()
+        self.assertEqual(len(kokkos.get_deferred_names()), 0)
+
+    def test_view_map_file(self):
+        """map_file"""
+        _data = [1.0 * i for i in range(16)]
+        with tempfile.TemporaryDirectory() as _dir:
+            _path = os.path.join(_dir, "data.bin")
+            with open(_path, "wb") as _f:
+                _f.write(struct.pack("16d", *_data))
+
+            # a 4x3 view of the elements after the first four
+            _view = kokkos.map_file(
+                _path, [4, 3], dtype=kokkos.float64, offset=32, advice="sequential"
+            )
+            self.assertEqual(_view.space, kokkos.HostSpace)
+            self.assertEqual(_view[0, 0], 4.0)
+            self.assertEqual(_view[3, 2], 15.0)
+
+            # copy-on-write: the file is not modified
+            _view[0, 0] = -1.0
+            del _view
+            with open(_path, "rb") as _f:
+                self.assertEqual(list(struct.unpack("16d", _f.read())), _data)
+
+            _view = kokkos.map_file(_path, [16], dtype=kokkos.float64, mode="r+")
+            _view[1] = -1.0
+            del _view
+            with open(_path, "rb") as _f:
+                self.assertEqual(struct.unpack("16d", _f.read())[1], -1.0)
+
+            with self.assertRaises(ValueError):
+                kokkos.map_file(_path, [17], dtype=kokkos.float64)
+
+            # a host mirror view shares the mapping and keeps it alive
+            _view = kokkos.map_file(_path, [16], dtype=kokkos.float64)
+            _mirror = _view.create_mirror_view(copy=False)
+            del _view
+            self.assertEqual(_mirror[1], -1.0)
+            del _mirror
+
+            # the buffer has to cover the extents of the view
+            _mapping = kokkos.MappedFile(_path, "r")
+            with self.assertRaises(ValueError):
+                kokkos.array(
+                    [17],
+                    array=_mapping,
+                    dtype=kokkos.float64,
+                    space=kokkos.HostSpace,
+                    trait=kokkos.Unmanaged,
+                )
+            del _mapping
+
 
 # main runner
 def run():
@@ -162,6 +162,7 @@ def array(
     trait=lib.Managed,
     dynamic=False,
     order=None,
+    initialize=True,
 ):
     [shape, label, array, dtype, layout] = _determine_array_input(
         shape_label_or_array, shape, label, array, dtype, layout
@@ -174,6 +175,18 @@ def array(
         elif order.upper() == "F":
             layout = lib.LayoutLeft
 
+    # the enumerations index the table of view constructors in libpykokkos
+    if (
+        array is None
+        and isinstance(dtype, lib.dtype)
+        and isinstance(space, lib.memory_space)
+        and isinstance(layout, lib.layout)
+        and (trait is None or isinstance(trait, lib.memory_trait))
+    ):
+        return lib.make_view(
+            dtype, space, layout, trait, len(shape), shape, label, initialize, dynamic
+        )
+
     _prefix = "KokkosView" if not dynamic else "KokkosDynRankView"
     _space = lib.get_memory_space(space)
     _dtype = lib.get_dtype(dtype)
@@ -211,7 +224,35 @@ def array(
     if label is None:
         label = f"{_label}>"
 
-    return getattr(lib, _name)(label if array is None else array, shape)
+    if array is not None:
+        return getattr(lib, _name)(array, shape)
+
+    # initialize=False skips the zero-initialization of the allocation
+    return getattr(lib, _name)(label, shape, initialize)
+
+
+def empty_like(view, label=None):
+    """Create a new managed view with the same data type, memory space, layout,
+    memory trait, and shape as the provided view without initializing the data"""
+
+    _shape = list(view.shape)
+    _trait = view.trait
+    if _trait == lib.Unmanaged:
+        _trait = lib.Managed
+    if view.dynamic:
+        # the extents of the unused ranks of a DynRankView are reported as one
+        _shape = _shape[: view.ndim]
+
+    return array(
+        _shape,
+        label=label,
+        dtype=view.dtype,
+        space=view.space,
+        layout=view.layout,
+        trait=_trait,
+        dynamic=view.dynamic,
+        initialize=False,
+    )
 
 
 def unmanaged_array(*_args, **_kwargs):
@@ -234,6 +275,204 @@ def deep_copy(dst, src):
     return dst.deep_copy(src)
 
 
+def deep_copy_async(dst, src, space=None):
+    """Performs Kokkos::deep_copy on an execution space instance (default
+    instance of the execution space of dst if not provided) and returns a
+    kokkos.Future which completes when that instance has completed the copy"""
+    return dst.deep_copy_async(src, space)
+
+
+def load(path, space=lib.HostSpace, label=None, direct=False):
+    """Create a managed view from a file written by view.save(path). The data
+    type, layout, shape, and (unless provided) the label are read from the
+    header of the file. direct=True uses O_DIRECT when supported"""
+
+    _header = lib.read_view_header(path)
+    _label = _header["label"] if label is None else label
+    _view = lib.make_view(
+        _header["dtype"],
+        space,
+        _header["layout"],
+        lib.Managed,
+        _header["rank"],
+        _header["shape"],
+        _label,
+        False,
+        _header["dynamic"],
+    )
+    _view.load(path, direct)
+    return _view
+
+
+def map_file(
+    path,
+    shape,
+    dtype=lib.double,
+    mode="r",
+    offset=0,
+    advice="normal",
+    layout=lib.LayoutRight,
+):
+    """Create an unmanaged HostSpace view over a memory-mapped region of a
+    file starting at the offset (bytes). The view keeps the file mapped.
+    mode is one of "r" (copy-on-write, the file is never modified), "r+"
+    (writes go to the file), or "w+" (create or truncate the file).
+    advice is the madvise hint ("normal", "sequential", "random",
+    "willneed", or "dontneed")"""
+
+    _itemsize = lib.get_dtype_size(dtype)
+    if offset % _itemsize != 0:
+        raise ValueError(
+            f"Offset {offset} is not a multiple of the data type size {_itemsize}"
+        )
+
+    _length = _itemsize
+    for _extent in shape:
+        _length *= _extent
+
+    _mapping = lib.MappedFile(path, mode, offset, _length)
+    _mapping.advise(advice)
+    return array(
+        list(shape),
+        array=_mapping,
+        dtype=dtype,
+        space=lib.HostSpace,
+        layout=layout,
+        trait=lib.Unmanaged,
+    )
+
+
+def dual_view(
+    shape,
+    label=None,
+    dtype=lib.double,
+    space=lib.DefaultMemorySpace,
+    layout=lib.LayoutRight,
+):
+    """Create a Kokkos::DualView, i.e. a view in the given memory space and
+    its host mirror with modify/sync tracking"""
+
+    _dtype = lib.get_dtype(dtype)
+    _space = lib.get_memory_space(space)
+    _layout = lib.get_layout(layout)
+    _ndim = len(shape)
+
+    if _ndim > lib.max_concrete_rank:
+        raise ValueError(
+            "pykokkos-base build only supports {} ranks. Requested {} ranks".format(
+                lib.max_concrete_rank, _ndim
+            )
+        )
+
+    _name = f"KokkosDualView_{_dtype}_{_space}_{_layout}_{_ndim}"
+    if label is None:
+        label = f"KokkosDualView<{_dtype}{'*' * _ndim}, {_layout}, {_space}>"
+
+    return getattr(lib, _name)(label, list(shape))
+
+
+def unordered_map(key=lib.int64, value=None, space=lib.DefaultMemorySpace, capacity=0):
+    """Create a Kokkos::UnorderedMap with integer keys. When value is None,
+    a set (Kokkos::UnorderedMap<Key, void>) is created"""
+
+    _key = lib.get_dtype(key)
+    _space = lib.get_memory_space(space)
+
+    if _key not in ("int32", "int64", "uint32", "uint64"):
+        raise ValueError(f"Key data type {_key} not supported, only integers.")
+
+    if value is None:
+        _name = f"KokkosUnorderedSet_{_key}_{_space}"
+    else:
+        _name = f"KokkosUnorderedMap_{_key}_{lib.get_dtype(value)}_{_space}"
+
+    return getattr(lib, _name)(capacity)
+
+
+def scatter_view(view, op="sum", duplicated=None):
+    """Create a Kokkos::Experimental::ScatterView for a one-dimensional view.
+    op is one of "sum", "prod", "min", or "max". A duplicated scatter view
+    gives every thread a copy and combines them in contribute_into, otherwise
+    the updates are applied atomically to the view. By default, duplication
+    is used when the execution space of the memory space is a host space"""
+
+    if op not in ("sum", "prod", "min", "max"):
+        raise ValueError(f"Scatter operation {op} not supported")
+
+    _dtype = lib.get_dtype(view.dtype)
+    _space = lib.get_memory_space(view.space)
+    _prefix = f"KokkosScatterView_{_dtype}_{_space}_{op}"
+
+    # duplicated scatter views are only generated for host execution spaces
+    if duplicated is None:
+        duplicated = hasattr(lib, f"{_prefix}_duplicated")
+
+    _mode = "duplicated" if duplicated else "atomic"
+    return getattr(lib, f"{_prefix}_{_mode}")(view)
+
+
+def bitset(size, space=lib.DefaultMemorySpace):
+    """Create a Kokkos::Bitset with size bits which are all reset"""
+
+    _space = lib.get_memory_space(space)
+    return getattr(lib, f"KokkosBitset_{_space}")(size)
+
+
+def growable_array(
+    dtype=lib.double,
+    space=lib.DefaultMemorySpace,
+    label="growable",
+    chunk_size=1024,
+    max_extent=1 << 28,
+):
+    """Create a one-dimensional Kokkos::Experimental::DynamicView which grows
+    in chunks on append/extend without moving the existing elements.
+    Use to_view() for a contiguous copy"""
+
+    _dtype = lib.get_dtype(dtype)
+    _space = lib.get_memory_space(space)
+    _name = f"KokkosGrowableView_{_dtype}_{_space}"
+
+    return getattr(lib, _name)(label, chunk_size, max_extent)
+
+
+def offset_view(view, begins):
+    """Create a Kokkos::Experimental::OffsetView which shares the allocation
+    of the view and indexes dimension i starting at begins[i] (which may be
+    negative, e.g. for halo regions)"""
+
+    _ndim = view.ndim
+    if len(begins) != _ndim:
+        raise ValueError(
+            f"Expected {_ndim} begin indices for a rank {_ndim} view, not {len(begins)}"
+        )
+
+    _dtype = lib.get_dtype(view.dtype)
+    _space = lib.get_memory_space(view.space)
+    _layout = lib.get_layout(view.layout)
+    _name = f"KokkosOffsetView_{_dtype}_{_space}_{_layout}_{_ndim}"
+
+    return getattr(lib, _name)(view, list(begins))
+
+
+def crs_matrix(row_map, entries, values, num_cols):
+    """Create a compressed sparse row matrix from one-dimensional views of the
+    row offsets (num_rows + 1), the column indices, and the values. The row
+    map and the entries must have the same integer data type"""
+
+    _dtype = lib.get_dtype(values.dtype)
+    _ordinal = lib.get_dtype(entries.dtype)
+    _space = lib.get_memory_space(values.space)
+
+    if _ordinal not in ("int32", "int64"):
+        raise ValueError(
+            f"Ordinal data type {_ordinal} not supported, only int32 and int64."
+        )
+
+    _name = f"KokkosCrsMatrix_{_dtype}_{_ordinal}_{_space}"
+    return getattr(lib, _name)(row_map, entries, values, num_cols)
+
+
 def random_pool(state, space, seed=None):
     """Create a Random_XorShift Pool"""
 
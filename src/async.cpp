@@ -0,0 +1,363 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include "async.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "common.hpp"
+#include "libpykokkos.hpp"
+
+//----------------------------------------------------------------------------//
+
+struct async_future::state {
+  std::mutex mutex           = {};
+  std::atomic<bool> complete = {false};
+  bool resolved              = false;
+  bool deferred              = false;
+  fence_func_t fence         = {};
+  query_func_t query         = {};
+  value_func_t value         = {};
+  py::object result          = {};
+  py::object error           = {};
+
+  // deferred futures are completed by resolve() instead of a fence
+  std::condition_variable cv             = {};
+  std::vector<callback_func_t> callbacks = {};
+};
+
+async_future::async_future(fence_func_t _fence, query_func_t _query,
+                           value_func_t _value)
+    : m_state{std::make_shared<state>()} {
+  m_state->fence = std::move(_fence);
+  m_state->query = std::move(_query);
+  m_state->value = std::move(_value);
+}
+
+void async_future::fence() const {
+  if (!m_state || m_state->complete.load()) return;
+  std::unique_lock<std::mutex> _lk{m_state->mutex};
+  if (m_state->deferred) {
+    m_state->cv.wait(_lk, [this]() { return m_state->complete.load(); });
+    return;
+  }
+  if (m_state->complete.load()) return;
+  if (m_state->fence) m_state->fence();
+  m_state->complete.store(true);
+}
+
+void async_future::wait() const {
+  if (!m_state || m_state->complete.load()) return;
+  py::gil_scoped_release _nogil{};
+  fence();
+}
+
+bool async_future::done() const {
+  if (!m_state || m_state->complete.load()) return true;
+  if (m_state->query && m_state->query()) {
+    m_state->complete.store(true);
+    return true;
+  }
+  return false;
+}
+
+py::object async_future::result() const {
+  if (!m_state) return py::none();
+  wait();
+  // the GIL serializes the resolution of the value
+  if (!m_state->resolved) {
+    m_state->result   = (m_state->value) ? m_state->value() : py::none();
+    m_state->resolved = true;
+    m_state->value    = value_func_t{};
+  }
+  if (m_state->error) {
+    PyErr_SetObject(reinterpret_cast<PyObject *>(Py_TYPE(m_state->error.ptr())),
+                    m_state->error.ptr());
+    throw py::error_already_set{};
+  }
+  return m_state->result;
+}
+
+async_future async_future::then(py::function _func) const {
+  auto _chained = deferred();
+  auto _parent  = *this;
+  add_done_callback(_parent, [_parent, _func, _chained]() {
+    _chained.resolve([&]() -> py::object { return _func(_parent.result()); });
+  });
+  return _chained;
+}
+
+async_future async_future::deferred() {
+  auto _future              = async_future{};
+  _future.m_state           = std::make_shared<state>();
+  _future.m_state->deferred = true;
+  return _future;
+}
+
+void async_future::resolve(const value_func_t &_get) const {
+  auto _value = py::object{};
+  auto _error = py::object{};
+  try {
+    _value = _get();
+    // flatten futures: the inner future is chained through the waiter
+    // thread instead of blocking on its result
+    if (py::isinstance<async_future>(_value)) {
+      auto _self  = *this;
+      auto _inner = _value.cast<async_future>();
+      add_done_callback(_inner, [_self, _inner]() {
+        _self.resolve([&_inner]() { return _inner.result(); });
+      });
+      return;
+    }
+  } catch (py::error_already_set &_err) {
+    _error = _err.value();
+  } catch (std::exception &_err) {
+    _error = py::reinterpret_borrow<py::object>(PyExc_RuntimeError)(
+        _err.what());
+  }
+
+  auto _callbacks = std::vector<callback_func_t>{};
+  {
+    std::lock_guard<std::mutex> _lk{m_state->mutex};
+    m_state->result   = std::move(_value);
+    m_state->error    = std::move(_error);
+    m_state->resolved = true;
+    m_state->complete.store(true);
+    std::swap(_callbacks, m_state->callbacks);
+  }
+  m_state->cv.notify_all();
+  // the future has completed so the waiter thread invokes the callbacks
+  // without blocking
+  for (auto &itr : _callbacks) add_done_callback(*this, std::move(itr));
+}
+
+bool async_future::defer_callback(callback_func_t &_func) const {
+  if (!m_state || !m_state->deferred) return false;
+  std::lock_guard<std::mutex> _lk{m_state->mutex};
+  if (m_state->complete.load()) return false;
+  m_state->callbacks.emplace_back(std::move(_func));
+  return true;
+}
+
+//----------------------------------------------------------------------------//
+
+namespace {
+class async_waiter {
+ public:
+  using callback_t = std::function<void()>;
+
+  static async_waiter &instance() {
+    // intentionally leaked: the thread is joined by finalize_async()
+    static auto *_instance = new async_waiter{};
+    return *_instance;
+  }
+
+  void submit(const async_future &_future, callback_t _func) {
+    {
+      std::lock_guard<std::mutex> _lk{m_mutex};
+      if (!m_thread.joinable()) {
+        m_stop   = false;
+        m_thread = std::thread{&async_waiter::execute, this};
+      }
+      m_queue.emplace_back(new entry{_future, std::move(_func)});
+    }
+    m_cv.notify_one();
+  }
+
+  // must be called without the GIL
+  void shutdown() {
+    {
+      std::lock_guard<std::mutex> _lk{m_mutex};
+      if (!m_thread.joinable()) return;
+      m_stop = true;
+    }
+    m_cv.notify_one();
+    m_thread.join();
+  }
+
+ private:
+  struct entry {
+    async_future future;
+    callback_t callback;
+  };
+
+  using entry_ptr_t = std::unique_ptr<entry>;
+
+  // prefer an entry which has already completed over fencing the oldest one
+  entry_ptr_t next() {
+    for (auto itr = m_queue.begin(); itr != m_queue.end(); ++itr) {
+      if ((*itr)->future.done()) {
+        auto _entry = std::move(*itr);
+        m_queue.erase(itr);
+        return _entry;
+      }
+    }
+    auto _entry = std::move(m_queue.front());
+    m_queue.pop_front();
+    return _entry;
+  }
+
+  void execute() {
+    while (true) {
+      entry_ptr_t _entry = {};
+      {
+        std::unique_lock<std::mutex> _lk{m_mutex};
+        m_cv.wait(_lk, [this]() { return m_stop || !m_queue.empty(); });
+        if (m_queue.empty()) return;
+        _entry = next();
+      }
+
+      _entry->future.fence();
+
+      // the callback and the future may hold the last reference to python
+      // objects so they are released with the GIL held
+      py::gil_scoped_acquire _gil{};
+      try {
+        _entry->callback();
+      } catch (py::error_already_set &_err) {
+        _err.discard_as_unraisable("kokkos.Future callback");
+      } catch (std::exception &_err) {
+        std::cerr << "[pykokkos]> exception in kokkos.Future callback: "
+                  << _err.what() << std::endl;
+      }
+      _entry.reset();
+    }
+  }
+
+  bool m_stop                     = false;
+  std::mutex m_mutex              = {};
+  std::condition_variable m_cv    = {};
+  std::deque<entry_ptr_t> m_queue = {};
+  std::thread m_thread            = {};
+};
+
+// resolves an asyncio.Future on the thread running its event loop
+void set_asyncio_result(const async_future &_future, py::object _pyfut) {
+  if (_pyfut.attr("done")().cast<bool>()) return;
+  try {
+    _pyfut.attr("set_result")(_future.result());
+  } catch (py::error_already_set &_err) {
+    _pyfut.attr("set_exception")(_err.value());
+  }
+}
+}  // namespace
+
+void add_done_callback(const async_future &_future,
+                       std::function<void()> _func) {
+  // deferred futures are resolved from the waiter thread so it must never
+  // wait for them
+  if (_future.defer_callback(_func)) return;
+  async_waiter::instance().submit(_future, std::move(_func));
+}
+
+// joins the background waiter thread after all pending callbacks have run
+void finalize_async() {
+  py::gil_scoped_release _nogil{};
+  async_waiter::instance().shutdown();
+}
+
+//----------------------------------------------------------------------------//
+
+void generate_async(py::module &kokkos) {
+  py::class_<async_future> _future(
+      kokkos, "Future",
+      "Handle to asynchronous work submitted to an execution space instance");
+
+  _future.def(py::init([]() { return new async_future{}; }),
+              "Create a future which is already complete");
+  _future.def("wait", &async_future::wait,
+              "Block until the work has completed. Only the execution space "
+              "instance the work was submitted to is fenced");
+  _future.def("done", &async_future::done,
+              "Non-blocking query of whether the work has completed. The "
+              "query is supported on the host backends, CUDA, and HIP. On "
+              "other backends (e.g. SYCL, OpenMPTarget, HPX) it only returns "
+              "True once the future has been waited upon");
+  _future.def("result", &async_future::result,
+              "Wait for the work to complete and return its value (None when "
+              "the operation does not produce a value)");
+  _future.def("then", &async_future::then, py::arg("func"),
+              "Return a future resolving to func(result()). func is invoked "
+              "from the background waiter thread once the work has completed. "
+              "If func returns a Future, the returned future resolves to its "
+              "result once it has completed");
+  _future.def(
+      "add_done_callback",
+      [](const async_future &_f, py::function _func) {
+        if (_f.done()) {
+          _func(_f);
+          return;
+        }
+        add_done_callback(_f, [_f, _func]() { _func(_f); });
+      },
+      py::arg("func"),
+      "Invoke func(future) once the work has completed. The completion is "
+      "awaited on a background thread which does not hold the GIL and func "
+      "is invoked from that thread");
+  _future.def(
+      "__await__",
+      [](const async_future &_f) {
+        auto _loop  = py::module::import("asyncio").attr("get_running_loop")();
+        auto _pyfut = _loop.attr("create_future")();
+        if (_f.done()) {
+          set_asyncio_result(_f, _pyfut);
+        } else {
+          add_done_callback(_f, [_f, _loop, _pyfut]() {
+            _loop.attr("call_soon_threadsafe")(
+                py::cpp_function(
+                    [_f, _pyfut]() { set_asyncio_result(_f, _pyfut); }));
+          });
+        }
+        return _pyfut.attr("__await__")();
+      },
+      "Await the completion from an asyncio event loop without blocking it");
+
+  // join the waiter thread before the interpreter tears down
+  py::module::import("atexit").attr("register")(
+      py::cpp_function([]() { finalize_async(); }));
+}
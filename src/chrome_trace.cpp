@@ -0,0 +1,357 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common.hpp"
+#include "tools.hpp"
+
+//----------------------------------------------------------------------------//
+//
+//        Chrome trace-event (Perfetto compatible) JSON exporter
+//
+//----------------------------------------------------------------------------//
+
+namespace {
+void write_json_string(std::ostream& _os, const std::string& _str) {
+  _os << '"';
+  for (char c : _str) {
+    switch (c) {
+      case '"': _os << "\\\""; break;
+      case '\\': _os << "\\\\"; break;
+      case '\n': _os << "\\n"; break;
+      case '\r': _os << "\\r"; break;
+      case '\t': _os << "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char _buf[8];
+          snprintf(_buf, sizeof(_buf), "\\u%04x", c);
+          _os << _buf;
+        } else {
+          _os << c;
+        }
+    }
+  }
+  _os << '"';
+}
+
+// timestamps are written in microseconds relative to the start of the trace
+void write_timestamp(std::ostream& _os, uint64_t _ns) {
+  _os << (_ns / 1000) << '.';
+  auto _rem = _ns % 1000;
+  if (_rem < 100) _os << '0';
+  if (_rem < 10) _os << '0';
+  _os << _rem;
+}
+
+struct trace_event {
+  char phase           = 'X';
+  const char* category = "";
+  std::string name     = {};
+  uint32_t track       = 0;
+  uint64_t begin       = 0;
+  uint64_t duration    = 0;
+  uint64_t id          = 0;   // flow id
+  int64_t value        = 0;   // counter value
+  std::string args     = {};  // serialized JSON object
+};
+
+class chrome_trace : public pykokkos_tools::native_tool {
+ public:
+  static chrome_trace& instance() {
+    return pykokkos_tools::leaked_instance<chrome_trace>();
+  }
+
+  void end_kernel(const pykokkos_tools::kernel_event& _event) override {
+    static const char* _types[] = {"parallel_for", "parallel_reduce",
+                                   "parallel_scan", "fence"};
+    auto _track = std::string{"Device "} + std::to_string(_event.device);
+    auto _args  = std::string{"{\"type\":\""} + _types[_event.kind] + "\"}";
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    push_complete(_event.kind == pykokkos_tools::Fence ? "fence" : "kernel",
+                  _event.name, get_track(_track), _event.begin, _event.end,
+                  std::move(_args));
+  }
+
+  void pop_region(const char* _name, uint64_t _begin, uint64_t _end) override {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    push_complete("region", _name, get_track(get_thread_track()), _begin,
+                  _end);
+  }
+
+  void stop_section(const char* _name, uint32_t, uint64_t _begin,
+                    uint64_t _end) override {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    push_complete("section", _name, get_track(get_thread_track()), _begin,
+                  _end);
+  }
+
+  // the copy is shown on the tracks of both memory spaces, connected by a
+  // flow arrow from the source to the destination
+  void end_deep_copy(const pykokkos_tools::deep_copy_event& _event) override {
+    std::ostringstream _args{};
+    _args << "{\"bytes\":" << _event.size << ",\"src\":";
+    write_json_string(_args, _event.src_label);
+    _args << ",\"dst\":";
+    write_json_string(_args, _event.dst_label);
+    _args << '}';
+
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    auto _src = get_track(std::string{"Space "} + _event.src_space);
+    auto _dst = get_track(std::string{"Space "} + _event.dst_space);
+    auto _id  = ++m_flow_count;
+    push_complete("deep_copy", "deep_copy", _src, _event.begin, _event.end,
+                  _args.str());
+    push_complete("deep_copy", "deep_copy", _dst, _event.begin, _event.end,
+                  _args.str());
+    push_flow('s', _src, _event.begin, _id);
+    push_flow('f', _dst, _event.begin, _id);
+  }
+
+  void mark_event(const char* _name, uint64_t _ts) override {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    auto _event     = trace_event{};
+    _event.phase    = 'i';
+    _event.category = "mark";
+    _event.name     = _name;
+    _event.track    = get_track(get_thread_track());
+    _event.begin    = _ts;
+    m_events.emplace_back(std::move(_event));
+  }
+
+  void allocate_data(const space_handle_t& _space, const char*,
+                     const void* _ptr, uint64_t _size) override {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    m_allocations[_ptr] = _size;
+    push_counter(_space.name, m_memory[_space.name] += _size);
+  }
+
+  void deallocate_data(const space_handle_t& _space, const char*,
+                       const void* _ptr, uint64_t) override {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    // ignore the allocations which happened before the trace was started
+    auto itr = m_allocations.find(_ptr);
+    if (itr == m_allocations.end()) return;
+    push_counter(_space.name, m_memory[_space.name] -= itr->second);
+    m_allocations.erase(itr);
+  }
+
+  void start() {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    if (m_events.empty()) m_origin = pykokkos_tools::get_timestamp();
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    m_events.clear();
+    m_memory.clear();
+    m_allocations.clear();
+    m_origin = pykokkos_tools::get_timestamp();
+  }
+
+  void write(std::ostream& _os) {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    _os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    _os << "{\"ph\":\"M\",\"pid\":0,\"tid\":0,\"name\":\"process_name\","
+           "\"args\":{\"name\":\"kokkos\"}}";
+    for (size_t i = 0; i < m_tracks.size(); ++i) {
+      _os << ",\n{\"ph\":\"M\",\"pid\":0,\"tid\":" << i
+          << ",\"name\":\"thread_name\",\"args\":{\"name\":";
+      write_json_string(_os, m_tracks.at(i));
+      _os << "}}";
+      _os << ",\n{\"ph\":\"M\",\"pid\":0,\"tid\":" << i
+          << ",\"name\":\"thread_sort_index\",\"args\":{\"sort_index\":" << i
+          << "}}";
+    }
+    for (const auto& itr : m_events) {
+      _os << ",\n{\"ph\":\"" << itr.phase << "\",\"pid\":0,\"tid\":"
+          << itr.track << ",\"cat\":\"" << itr.category << "\",\"name\":";
+      write_json_string(_os, itr.name);
+      _os << ",\"ts\":";
+      write_timestamp(_os, relative(itr.begin));
+      switch (itr.phase) {
+        case 'X':
+          _os << ",\"dur\":";
+          write_timestamp(_os, itr.duration);
+          break;
+        case 'i': _os << ",\"s\":\"t\""; break;
+        case 's': _os << ",\"id\":" << itr.id; break;
+        case 'f': _os << ",\"id\":" << itr.id << ",\"bp\":\"e\""; break;
+        case 'C': _os << ",\"args\":{\"bytes\":" << itr.value << "}"; break;
+      }
+      if (!itr.args.empty()) _os << ",\"args\":" << itr.args;
+      _os << '}';
+    }
+    _os << "\n]}\n";
+  }
+
+ private:
+  uint64_t relative(uint64_t _ts) const {
+    return (_ts > m_origin) ? (_ts - m_origin) : 0;
+  }
+
+  static std::string get_thread_track() {
+    static std::atomic<uint32_t> _thread_count{0};
+    static thread_local auto _value =
+        std::string{"Host thread "} + std::to_string(_thread_count++);
+    return _value;
+  }
+
+  // requires the lock
+  uint32_t get_track(const std::string& _name) {
+    auto itr = m_track_ids.find(_name);
+    if (itr != m_track_ids.end()) return itr->second;
+    m_tracks.emplace_back(_name);
+    auto _id = static_cast<uint32_t>(m_tracks.size() - 1);
+    m_track_ids.emplace(_name, _id);
+    return _id;
+  }
+
+  void push_complete(const char* _category, const char* _name, uint32_t _track,
+                     uint64_t _begin, uint64_t _end, std::string _args = {}) {
+    auto _event     = trace_event{};
+    _event.category = _category;
+    _event.name     = _name;
+    _event.track    = _track;
+    _event.begin    = _begin;
+    _event.duration = (_end > _begin) ? (_end - _begin) : 0;
+    _event.args     = std::move(_args);
+    m_events.emplace_back(std::move(_event));
+  }
+
+  void push_flow(char _phase, uint32_t _track, uint64_t _ts, uint64_t _id) {
+    auto _event     = trace_event{};
+    _event.phase    = _phase;
+    _event.category = "deep_copy";
+    _event.name     = "deep_copy";
+    _event.track    = _track;
+    _event.begin    = _ts;
+    _event.id       = _id;
+    m_events.emplace_back(std::move(_event));
+  }
+
+  void push_counter(const char* _space, int64_t _value) {
+    auto _event     = trace_event{};
+    _event.phase    = 'C';
+    _event.category = "memory";
+    _event.name     = std::string{_space} + " memory";
+    _event.begin    = pykokkos_tools::get_timestamp();
+    _event.value    = _value;
+    m_events.emplace_back(std::move(_event));
+  }
+
+  std::mutex m_mutex                                      = {};
+  uint64_t m_origin                                       = 0;
+  uint64_t m_flow_count                                   = 0;
+  std::vector<trace_event> m_events                       = {};
+  std::vector<std::string> m_tracks                       = {};
+  std::unordered_map<std::string, uint32_t> m_track_ids   = {};
+  std::unordered_map<std::string, int64_t> m_memory       = {};
+  std::unordered_map<const void*, uint64_t> m_allocations = {};
+};
+}  // namespace
+
+void generate_chrome_trace(py::module& tools) {
+  auto _trace = tools.def_submodule(
+      "chrome_trace",
+      "Native exporter of the Kokkos Tools events to the Chrome trace-event "
+      "JSON format, viewable in chrome://tracing or ui.perfetto.dev");
+
+  _trace.def(
+      "start",
+      []() {
+        auto* _tool = &chrome_trace::instance();
+        _tool->start();
+        pykokkos_tools::add_native_tool(_tool, pykokkos_tools::AllEvents);
+      },
+      "Start tracing. Events are appended to the events of the previous "
+      "traces until clear() is called");
+
+  _trace.def(
+      "stop",
+      []() { pykokkos_tools::remove_native_tool(&chrome_trace::instance()); },
+      "Stop tracing");
+
+  _trace.def(
+      "running",
+      []() {
+        return pykokkos_tools::has_native_tool(&chrome_trace::instance());
+      },
+      "Whether events are being traced");
+
+  _trace.def(
+      "clear", []() { chrome_trace::instance().clear(); },
+      "Discard the traced events");
+
+  _trace.def(
+      "dumps",
+      []() {
+        std::ostringstream _os{};
+        {
+          py::gil_scoped_release _gil{};
+          chrome_trace::instance().write(_os);
+        }
+        return _os.str();
+      },
+      "Returns the trace as a JSON string");
+
+  _trace.def(
+      "save",
+      [](const std::string& _filename) {
+        py::gil_scoped_release _gil{};
+        std::ofstream _ofs{_filename};
+        if (!_ofs)
+          throw std::runtime_error("Error! unable to open '" + _filename +
+                                   "' for writing");
+        chrome_trace::instance().write(_ofs);
+      },
+      "Write the trace to a JSON file", py::arg("filename"));
+}
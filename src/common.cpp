@@ -44,7 +44,9 @@
 
 #include "common.hpp"
 
+#include <map>
 #include <regex>
+#include <unordered_map>
 
 //----------------------------------------------------------------------------//
 
@@ -83,13 +85,32 @@ std::string Impl::remove_type_list_wrapper(std::string _tmp) {
 
 //----------------------------------------------------------------------------//
 
-std::set<std::string> &get_existing_pyclass_names() {
-  static std::set<std::string> _instance{};
+std::unordered_set<std::type_index> &get_existing_pyclass_types() {
+  static std::unordered_set<std::type_index> _instance{};
   return _instance;
 }
 
 //----------------------------------------------------------------------------//
 
+namespace {
+bool get_env_flag(const char *_env_name, bool _default) {
+  auto _env_value = std::getenv(_env_name);
+  if (!_env_value) return _default;
+  auto var = std::string{_env_value};
+  if (var.find_first_not_of("0123456789") == std::string::npos) {
+    return (std::stoi(var) == 0) ? false : true;
+  } else if (std::regex_match(var, std::regex("^(off|false|no|n|f)$",
+                                              std::regex_constants::icase))) {
+    return false;
+  } else if (std::regex_match(var, std::regex("^(on|true|yes|y|t)$",
+                                              std::regex_constants::icase)))
+    return true;
+  return _default;
+}
+}  // namespace
+
+//----------------------------------------------------------------------------//
+
 bool debug_output() {
   static auto _value = []() {
 #if !defined(NDEBUG) || defined(DEBUG)
@@ -97,20 +118,75 @@ bool debug_output() {
 #else
     bool val = false;
 #endif
-    auto _env_value = std::getenv("DEBUG_OUTPUT");
-    if (_env_value) {
-      auto var = std::string{_env_value};
-      if (var.find_first_not_of("0123456789") == std::string::npos) {
-        val = (std::stoi(var) == 0) ? false : true;
-      } else if (std::regex_match(var,
-                                  std::regex("^(off|false|no|n|f)$",
-                                             std::regex_constants::icase))) {
-        val = false;
-      } else if (std::regex_match(var, std::regex("^(on|true|yes|y|t)$",
-                                                  std::regex_constants::icase)))
-        val = true;
-    }
-    return val;
+    return get_env_flag("DEBUG_OUTPUT", val);
   }();
   return _value;
 }
+
+//----------------------------------------------------------------------------//
+
+bool lazy_registration() {
+  static auto _value = get_env_flag("PYKOKKOS_BASE_LAZY_REGISTRATION", false);
+  return _value;
+}
+
+//----------------------------------------------------------------------------//
+
+namespace {
+// deferred classes are looked up by the python name (module __getattr__) and
+// by the C++ type (classes returned from methods of other classes)
+struct lazy_pyclass_registry {
+  std::map<std::string, std::pair<std::type_index, pyclass_thunk_t>> names = {};
+  std::unordered_map<std::type_index, std::string> types                   = {};
+};
+
+lazy_pyclass_registry &get_lazy_pyclass_registry() {
+  static auto *_instance = new lazy_pyclass_registry{};
+  return *_instance;
+}
+}  // namespace
+
+void add_lazy_pyclass(const std::string &_name, const std::type_info &_type,
+                      pyclass_thunk_t _thunk) {
+  auto &_registry = get_lazy_pyclass_registry();
+  // same as eager registration: the first name for a given type wins
+  if (_registry.types.count(_type) > 0) return;
+  _registry.types.emplace(_type, _name);
+  _registry.names.emplace(_name,
+                          std::make_pair(std::type_index{_type}, _thunk));
+}
+
+bool register_lazy_pyclass(py::module &_mod, const std::string &_name) {
+  auto &_registry = get_lazy_pyclass_registry();
+  auto itr        = _registry.names.find(_name);
+  if (itr == _registry.names.end()) return false;
+  auto _thunk = itr->second.second;
+  _registry.types.erase(itr->second.first);
+  _registry.names.erase(itr);
+  // erased beforehand since the thunk may register other deferred classes
+  _thunk(_mod);
+  return true;
+}
+
+bool register_lazy_pyclass(py::module &_mod, const std::type_info &_type) {
+  auto &_registry = get_lazy_pyclass_registry();
+  auto itr        = _registry.types.find(_type);
+  if (itr == _registry.types.end()) return false;
+  return register_lazy_pyclass(_mod, std::string{itr->second});
+}
+
+size_t register_all_pyclasses(py::module &_mod) {
+  auto &_registry = get_lazy_pyclass_registry();
+  size_t _n       = 0;
+  while (!_registry.names.empty()) {
+    if (register_lazy_pyclass(_mod, _registry.names.begin()->first)) ++_n;
+  }
+  return _n;
+}
+
+std::vector<std::string> get_lazy_pyclass_names() {
+  auto _names = std::vector<std::string>{};
+  for (const auto &itr : get_lazy_pyclass_registry().names)
+    _names.emplace_back(itr.first);
+  return _names;
+}
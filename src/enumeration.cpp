@@ -45,6 +45,7 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
 
+#include <array>
 #include <cassert>
 #include <iostream>
 
@@ -124,6 +125,14 @@ auto get_enumeration(const std::string &str,
 
 //----------------------------------------------------------------------------//
 
+template <template <size_t> class SpecT, size_t... Idx>
+auto get_enumeration_sizes(std::index_sequence<Idx...>) {
+  return std::array<size_t, sizeof...(Idx)>{
+      sizeof(typename SpecT<Idx>::type)...};
+}
+
+//----------------------------------------------------------------------------//
+
 void generate_enumeration(py::module &kokkos) {
   //----------------------------------------------------------------------------//
   //
@@ -186,6 +195,18 @@ void generate_enumeration(py::module &kokkos) {
   kokkos.def("get_dtype", _get_dtype_name, "Get the data type");
   kokkos.def("get_dtype", _get_dtype_idx, "Get the data type");
 
+  auto _get_dtype_size = [](int idx) {
+    static const auto _sizes =
+        get_enumeration_sizes<ViewDataTypeSpecialization>(
+            std::make_index_sequence<ViewDataTypesEnd>{});
+    // validates the index
+    get_enumeration<ViewDataTypeSpecialization>(
+        idx, std::make_index_sequence<ViewDataTypesEnd>{});
+    return _sizes.at(idx);
+  };
+  kokkos.def("get_dtype_size", _get_dtype_size,
+             "Get the size of the data type in bytes");
+
   //----------------------------------------------------------------------------//
   //
   //                                memory spaces
@@ -0,0 +1,414 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <pybind11/numpy.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "common.hpp"
+#include "tools.hpp"
+
+//----------------------------------------------------------------------------//
+//
+//        Native event recorder: per-thread ring buffers of fixed-size
+//        records which are drained in batch into a numpy structured array
+//
+//----------------------------------------------------------------------------//
+
+namespace {
+// the first values match pykokkos_tools::kernel_kind
+enum class event_kind : uint8_t {
+  ParallelFor = 0,
+  ParallelReduce,
+  ParallelScan,
+  Fence,
+  Region,
+  Section,
+  DeepCopy,
+  Allocate,
+  Deallocate,
+  Mark,
+};
+
+// begin/end events are recorded once they complete. The string fields are
+// interned ids, i.e. indexes into names(), where zero is the empty string
+struct event_record {
+  uint64_t timestamp;     // begin (ns)
+  uint64_t duration;      // zero for instantaneous events
+  uint64_t size;          // bytes (allocations, deep copies) or section id
+  uint32_t name;          // kernel, region, section, or mark name, or label
+  uint32_t space;         // memory space (allocations, deep copy destination)
+  uint32_t source;        // deep copy source label
+  uint32_t source_space;  // deep copy source memory space
+  uint32_t device;        // device id (kernels, fences)
+  uint32_t thread;        // index of the recording thread
+  uint8_t kind;           // event_kind
+};
+
+// the names are never removed so the ids remain valid across clear()
+class name_table {
+ public:
+  uint32_t intern(const char* _name) {
+    auto _key = std::string_view{_name};
+    auto itr  = m_cache.find(_key);
+    if (itr != m_cache.end()) return itr->second;
+
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    auto gitr = m_ids.find(_key);
+    if (gitr == m_ids.end()) {
+      m_names.emplace_back(_key);
+      auto _id = static_cast<uint32_t>(m_names.size() - 1);
+      gitr     = m_ids.emplace(std::string_view{m_names.back()}, _id).first;
+    }
+    // the key refers to the deque storage which never moves
+    m_cache.emplace(gitr->first, gitr->second);
+    return gitr->second;
+  }
+
+  py::list names() {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    py::list _value{};
+    for (const auto& itr : m_names) _value.append(itr);
+    return _value;
+  }
+
+ private:
+  std::mutex m_mutex                                   = {};
+  std::deque<std::string> m_names                      = {std::string{}};
+  std::unordered_map<std::string_view, uint32_t> m_ids = {{"", 0}};
+
+  // per-thread cache which avoids the lock for the names already seen
+  static thread_local std::unordered_map<std::string_view, uint32_t> m_cache;
+};
+
+thread_local std::unordered_map<std::string_view, uint32_t>
+    name_table::m_cache = {};
+
+// single producer (the owning thread), single consumer (drain under a lock)
+class ring_buffer {
+ public:
+  ring_buffer(size_t _capacity, uint32_t _thread)
+      : m_thread{_thread}, m_data(_capacity) {}
+
+  uint32_t thread() const { return m_thread; }
+
+  void push(const event_record& _record) {
+    auto _head = m_head.load(std::memory_order_relaxed);
+    auto _tail = m_tail.load(std::memory_order_acquire);
+    if (_head - _tail >= m_data.size()) {
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    m_data[_head % m_data.size()] = _record;
+    m_head.store(_head + 1, std::memory_order_release);
+  }
+
+  size_t size() const {
+    return m_head.load(std::memory_order_acquire) -
+           m_tail.load(std::memory_order_relaxed);
+  }
+
+  // copies at most _count records into _out and releases them
+  size_t drain(event_record* _out, size_t _count) {
+    auto _tail = m_tail.load(std::memory_order_relaxed);
+    auto _head = m_head.load(std::memory_order_acquire);
+    auto _num  = std::min<size_t>(_head - _tail, _count);
+    for (size_t i = 0; i < _num; ++i)
+      _out[i] = m_data[(_tail + i) % m_data.size()];
+    m_tail.store(_tail + _num, std::memory_order_release);
+    return _num;
+  }
+
+  void clear() {
+    m_tail.store(m_head.load(std::memory_order_acquire),
+                 std::memory_order_release);
+    m_dropped.store(0);
+  }
+
+  uint64_t dropped() const { return m_dropped.load(); }
+
+ private:
+  uint32_t m_thread                = 0;
+  std::atomic<uint64_t> m_head     = {0};
+  std::atomic<uint64_t> m_tail     = {0};
+  std::atomic<uint64_t> m_dropped  = {0};
+  std::vector<event_record> m_data = {};
+};
+
+class event_recorder : public pykokkos_tools::native_tool {
+ public:
+  static event_recorder& instance() {
+    return pykokkos_tools::leaked_instance<event_recorder>();
+  }
+
+  void end_kernel(const pykokkos_tools::kernel_event& _event) override {
+    record(static_cast<event_kind>(_event.kind), _event.begin,
+           _event.end - _event.begin, intern(_event.name), _event.device);
+  }
+
+  void pop_region(const char* _name, uint64_t _begin, uint64_t _end) override {
+    record(event_kind::Region, _begin, _end - _begin, intern(_name));
+  }
+
+  void stop_section(const char* _name, uint32_t _id, uint64_t _begin,
+                    uint64_t _end) override {
+    auto _record = make_record(event_kind::Section, _begin, _end - _begin,
+                               intern(_name));
+    _record.size = _id;
+    get_buffer().push(_record);
+  }
+
+  void end_deep_copy(const pykokkos_tools::deep_copy_event& _event) override {
+    auto _record         = make_record(event_kind::DeepCopy, _event.begin,
+                                       _event.end - _event.begin,
+                                       intern(_event.dst_label));
+    _record.size         = _event.size;
+    _record.space        = intern(_event.dst_space);
+    _record.source       = intern(_event.src_label);
+    _record.source_space = intern(_event.src_space);
+    get_buffer().push(_record);
+  }
+
+  void mark_event(const char* _name, uint64_t _ts) override {
+    record(event_kind::Mark, _ts, 0, intern(_name));
+  }
+
+  void allocate_data(const space_handle_t& _space, const char* _label,
+                     const void*, uint64_t _size) override {
+    record_allocation(event_kind::Allocate, _space, _label, _size);
+  }
+
+  void deallocate_data(const space_handle_t& _space, const char* _label,
+                       const void*, uint64_t _size) override {
+    record_allocation(event_kind::Deallocate, _space, _label, _size);
+  }
+
+  // buffers of the previous capacity are released once they are drained
+  void set_capacity(size_t _capacity) {
+    if (_capacity == 0)
+      throw std::runtime_error("Error! recorder capacity must be non-zero");
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    if (_capacity == m_capacity.load()) return;
+    m_capacity.store(_capacity);
+    m_generation.fetch_add(1);
+  }
+
+  py::array_t<event_record> drain() {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    size_t _count = 0;
+    for (const auto& itr : m_buffers) _count += itr.buffer->size();
+
+    auto _value =
+        py::array_t<event_record>(static_cast<py::ssize_t>(_count));
+    auto* _data = _value.mutable_data();
+    size_t _num = 0;
+    for (auto& itr : m_buffers)
+      _num += itr.buffer->drain(_data + _num, _count - _num);
+
+    // release the buffers of the previous capacity once they are empty
+    auto _generation = m_generation.load();
+    auto _stale      = [_generation](const buffer_entry& itr) {
+      return itr.generation != _generation && itr.buffer->size() == 0;
+    };
+    for (const auto& itr : m_buffers) {
+      if (_stale(itr)) m_dropped += itr.buffer->dropped();
+    }
+    m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(), _stale),
+                    m_buffers.end());
+
+    std::stable_sort(_data, _data + _num,
+                     [](const event_record& _lhs, const event_record& _rhs) {
+                       return _lhs.timestamp < _rhs.timestamp;
+                     });
+    return _value;
+  }
+
+  uint64_t dropped() {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    uint64_t _value = m_dropped;
+    for (const auto& itr : m_buffers) _value += itr.buffer->dropped();
+    return _value;
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    for (auto& itr : m_buffers) itr.buffer->clear();
+    m_dropped = 0;
+  }
+
+  py::list names() { return m_names.names(); }
+
+ private:
+  uint32_t intern(const char* _name) { return m_names.intern(_name); }
+
+  static event_record make_record(event_kind _kind, uint64_t _ts,
+                                  uint64_t _duration, uint32_t _name) {
+    auto _record      = event_record{};
+    _record.timestamp = _ts;
+    _record.duration  = _duration;
+    _record.name      = _name;
+    _record.kind      = static_cast<uint8_t>(_kind);
+    return _record;
+  }
+
+  void record(event_kind _kind, uint64_t _ts, uint64_t _duration,
+              uint32_t _name, uint32_t _device = 0) {
+    auto _record   = make_record(_kind, _ts, _duration, _name);
+    _record.device = _device;
+    get_buffer().push(_record);
+  }
+
+  void record_allocation(event_kind _kind, const space_handle_t& _space,
+                         const char* _label, uint64_t _size) {
+    auto _record  = make_record(_kind, pykokkos_tools::get_timestamp(), 0,
+                                intern(_label));
+    _record.space = intern(_space.name);
+    _record.size  = _size;
+    get_buffer().push(_record);
+  }
+
+  // the buffer of the calling thread is (re-)created when the capacity changes
+  ring_buffer& get_buffer() {
+    static std::atomic<uint32_t> _thread_count{0};
+    static thread_local uint32_t _thread                     = _thread_count++;
+    static thread_local uint64_t _generation                 = 0;
+    static thread_local std::shared_ptr<ring_buffer> _buffer = {};
+
+    auto _current = m_generation.load(std::memory_order_acquire);
+    if (!_buffer || _generation != _current) {
+      std::lock_guard<std::mutex> _lk{m_mutex};
+      _generation = m_generation.load();
+      _buffer     = std::make_shared<ring_buffer>(m_capacity.load(), _thread);
+      m_buffers.emplace_back(buffer_entry{_buffer, _generation});
+    }
+    return *_buffer;
+  }
+
+  struct buffer_entry {
+    std::shared_ptr<ring_buffer> buffer;
+    uint64_t generation;
+  };
+
+  name_table m_names                  = {};
+  std::mutex m_mutex                  = {};
+  std::atomic<size_t> m_capacity      = {65536};
+  std::atomic<uint64_t> m_generation  = {1};
+  uint64_t m_dropped                  = 0;
+  std::vector<buffer_entry> m_buffers = {};
+};
+}  // namespace
+
+void generate_event_recorder(py::module& tools) {
+  auto _recorder = tools.def_submodule(
+      "recorder",
+      "Native recording of the Kokkos Tools events into per-thread ring "
+      "buffers which are drained into a numpy structured array");
+
+  PYBIND11_NUMPY_DTYPE(event_record, timestamp, duration, size, name, space,
+                       source, source_space, device, thread, kind);
+
+  py::enum_<event_kind> _kind(_recorder, "event_kind", py::arithmetic(),
+                              "Kind of a recorded event");
+  _kind.value("ParallelFor", event_kind::ParallelFor)
+      .value("ParallelReduce", event_kind::ParallelReduce)
+      .value("ParallelScan", event_kind::ParallelScan)
+      .value("Fence", event_kind::Fence)
+      .value("Region", event_kind::Region)
+      .value("Section", event_kind::Section)
+      .value("DeepCopy", event_kind::DeepCopy)
+      .value("Allocate", event_kind::Allocate)
+      .value("Deallocate", event_kind::Deallocate)
+      .value("Mark", event_kind::Mark);
+  _kind.export_values();
+
+  _recorder.def(
+      "enable",
+      [](size_t _capacity) {
+        auto* _tool = &event_recorder::instance();
+        _tool->set_capacity(_capacity);
+        pykokkos_tools::add_native_tool(_tool, pykokkos_tools::AllEvents);
+      },
+      "Start recording. The capacity is the number of events per thread "
+      "which can be buffered between calls to drain() before events are "
+      "dropped",
+      py::arg("capacity") = 65536);
+
+  _recorder.def(
+      "disable",
+      []() { pykokkos_tools::remove_native_tool(&event_recorder::instance()); },
+      "Stop recording. The buffered events can still be drained");
+
+  _recorder.def(
+      "enabled",
+      []() {
+        return pykokkos_tools::has_native_tool(&event_recorder::instance());
+      },
+      "Whether the recorder is enabled");
+
+  _recorder.def(
+      "drain", []() { return event_recorder::instance().drain(); },
+      "Returns the buffered events, sorted by timestamp, as a numpy "
+      "structured array and releases them. The 'name', 'space', 'source', and "
+      "'source_space' fields index into names()");
+
+  _recorder.def(
+      "names", []() { return event_recorder::instance().names(); },
+      "Returns the list of interned names");
+
+  _recorder.def(
+      "dropped", []() { return event_recorder::instance().dropped(); },
+      "Number of events dropped because a buffer was full");
+
+  _recorder.def(
+      "clear", []() { event_recorder::instance().clear(); },
+      "Discard the buffered events and reset the dropped count");
+}
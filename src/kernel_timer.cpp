@@ -0,0 +1,295 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common.hpp"
+#include "tools.hpp"
+
+//----------------------------------------------------------------------------//
+//
+//        Kernel and region timer aggregation (simple-kernel-timer)
+//
+//----------------------------------------------------------------------------//
+
+namespace {
+enum timer_kind : uint8_t {
+  ParallelForTimer = 0,
+  ParallelReduceTimer,
+  ParallelScanTimer,
+  FenceTimer,
+  RegionTimer,
+  TimerKinds,
+};
+
+const char* get_timer_kind_name(size_t _kind) {
+  static const char* _names[TimerKinds] = {
+      "parallel_for", "parallel_reduce", "parallel_scan", "fence", "region"};
+  return _names[_kind];
+}
+
+struct timer_stats {
+  uint64_t count = 0;
+  uint64_t total = 0;
+  uint64_t min   = std::numeric_limits<uint64_t>::max();
+  uint64_t max   = 0;
+
+  void record(uint64_t _duration) {
+    ++count;
+    total += _duration;
+    min    = std::min(min, _duration);
+    max    = std::max(max, _duration);
+  }
+
+  timer_stats& operator+=(const timer_stats& _rhs) {
+    count += _rhs.count;
+    total += _rhs.total;
+    min    = std::min(min, _rhs.min);
+    max    = std::max(max, _rhs.max);
+    return *this;
+  }
+};
+
+using timer_map_t = std::unordered_map<std::string, timer_stats>;
+
+// each thread accumulates into its own tables so the lock is uncontended
+struct thread_timers {
+  std::mutex mutex                           = {};
+  std::string key                            = {};
+  std::array<timer_map_t, TimerKinds> timers = {};
+};
+
+struct timer_row {
+  std::string name  = {};
+  size_t kind       = 0;
+  timer_stats stats = {};
+};
+
+class kernel_timer : public pykokkos_tools::native_tool {
+ public:
+  static kernel_timer& instance() {
+    return pykokkos_tools::leaked_instance<kernel_timer>();
+  }
+
+  void end_kernel(const pykokkos_tools::kernel_event& _event) override {
+    record(static_cast<timer_kind>(_event.kind), _event.name,
+           _event.end - _event.begin);
+  }
+
+  void pop_region(const char* _name, uint64_t _begin, uint64_t _end) override {
+    record(RegionTimer, _name, _end - _begin);
+  }
+
+  void reset() {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    for (auto& itr : m_threads) {
+      std::lock_guard<std::mutex> _tlk{itr->mutex};
+      for (auto& titr : itr->timers) titr.clear();
+    }
+  }
+
+  // merges the tables of all the threads and sorts them by the given field
+  std::vector<timer_row> get_rows(const std::string& _sort) {
+    std::array<timer_map_t, TimerKinds> _merged{};
+    {
+      std::lock_guard<std::mutex> _lk{m_mutex};
+      for (auto& itr : m_threads) {
+        std::lock_guard<std::mutex> _tlk{itr->mutex};
+        for (size_t i = 0; i < TimerKinds; ++i) {
+          for (const auto& titr : itr->timers.at(i))
+            _merged.at(i)[titr.first] += titr.second;
+        }
+      }
+    }
+
+    std::vector<timer_row> _rows{};
+    for (size_t i = 0; i < TimerKinds; ++i) {
+      for (auto& itr : _merged.at(i))
+        _rows.emplace_back(timer_row{itr.first, i, itr.second});
+    }
+
+    auto _field = get_sort_field(_sort);
+    std::sort(_rows.begin(), _rows.end(),
+              [_field](const timer_row& _lhs, const timer_row& _rhs) {
+                auto _l = _field(_lhs.stats);
+                auto _r = _field(_rhs.stats);
+                return (_l != _r) ? (_l > _r) : (_lhs.name < _rhs.name);
+              });
+    return _rows;
+  }
+
+ private:
+  using sort_field_t = double (*)(const timer_stats&);
+
+  static sort_field_t get_sort_field(const std::string& _sort) {
+    if (_sort == "total")
+      return [](const timer_stats& _v) { return double(_v.total); };
+    if (_sort == "count")
+      return [](const timer_stats& _v) { return double(_v.count); };
+    if (_sort == "mean")
+      return [](const timer_stats& _v) { return double(_v.total) / _v.count; };
+    if (_sort == "min")
+      return [](const timer_stats& _v) { return double(_v.min); };
+    if (_sort == "max")
+      return [](const timer_stats& _v) { return double(_v.max); };
+    throw py::value_error("Error! unknown sort field '" + _sort +
+                          "', expected one of: total, count, mean, min, max");
+  }
+
+  void record(timer_kind _kind, const char* _name, uint64_t _duration) {
+    auto& _timers = get_thread_timers();
+    std::lock_guard<std::mutex> _lk{_timers.mutex};
+    // reuse the capacity of the key to avoid allocating for the lookup
+    _timers.key.assign(_name);
+    _timers.timers[_kind][_timers.key].record(_duration);
+  }
+
+  thread_timers& get_thread_timers() {
+    static thread_local std::shared_ptr<thread_timers> _value = [this]() {
+      auto _timers = std::make_shared<thread_timers>();
+      std::lock_guard<std::mutex> _lk{m_mutex};
+      m_threads.emplace_back(_timers);
+      return _timers;
+    }();
+    return *_value;
+  }
+
+  std::mutex m_mutex                                    = {};
+  std::vector<std::shared_ptr<thread_timers>> m_threads = {};
+};
+
+py::dict as_dict(const timer_row& _row) {
+  constexpr double _sec = 1.0e-9;
+  py::dict _value{};
+  _value["name"]  = _row.name;
+  _value["type"]  = get_timer_kind_name(_row.kind);
+  _value["count"] = _row.stats.count;
+  _value["total"] = _sec * _row.stats.total;
+  _value["min"]   = _sec * _row.stats.min;
+  _value["max"]   = _sec * _row.stats.max;
+  _value["mean"]  = _sec * _row.stats.total / _row.stats.count;
+  return _value;
+}
+
+std::string get_report(const std::vector<timer_row>& _rows) {
+  constexpr double _sec = 1.0e-9;
+  std::ostringstream _os{};
+  char _buf[256];
+  snprintf(_buf, sizeof(_buf), "%-16s %10s %12s %12s %12s %12s  %s\n", "type",
+           "count", "total (s)", "mean (s)", "min (s)", "max (s)", "name");
+  _os << _buf;
+  for (const auto& itr : _rows) {
+    snprintf(_buf, sizeof(_buf), "%-16s %10llu %12.6f %12.6f %12.6f %12.6f  ",
+             get_timer_kind_name(itr.kind),
+             static_cast<unsigned long long>(itr.stats.count),
+             _sec * itr.stats.total, _sec * itr.stats.total / itr.stats.count,
+             _sec * itr.stats.min, _sec * itr.stats.max);
+    _os << _buf << itr.name << "\n";
+  }
+  return _os.str();
+}
+}  // namespace
+
+void generate_kernel_timer(py::module& tools) {
+  auto _timer = tools.def_submodule(
+      "kernel_timer",
+      "Native aggregation of the count, total, min, max, and mean time per "
+      "kernel name and per region");
+
+  _timer.def(
+      "install",
+      []() {
+        using namespace pykokkos_tools;
+        auto* _tool = &kernel_timer::instance();
+        if (has_native_tool(_tool)) return;
+        _tool->reset();
+        add_native_tool(_tool, KernelEvents | FenceEvents | RegionEvents);
+      },
+      "Start timing the kernels, fences, and regions");
+
+  _timer.def(
+      "uninstall",
+      []() { pykokkos_tools::remove_native_tool(&kernel_timer::instance()); },
+      "Stop timing. The accumulated timers are retained");
+
+  _timer.def(
+      "installed",
+      []() {
+        return pykokkos_tools::has_native_tool(&kernel_timer::instance());
+      },
+      "Whether the kernel timer is installed");
+
+  _timer.def(
+      "reset", []() { kernel_timer::instance().reset(); },
+      "Discard the accumulated timers");
+
+  _timer.def(
+      "results",
+      [](const std::string& _sort) {
+        py::list _value{};
+        for (const auto& itr : kernel_timer::instance().get_rows(_sort))
+          _value.append(as_dict(itr));
+        return _value;
+      },
+      "Returns a list of {'name', 'type', 'count', 'total', 'min', 'max', "
+      "'mean'} (times in seconds) sorted in descending order by the given "
+      "field",
+      py::arg("sort") = "total");
+
+  _timer.def(
+      "report",
+      [](const std::string& _sort) {
+        return get_report(kernel_timer::instance().get_rows(_sort));
+      },
+      "Returns the results formatted as a table", py::arg("sort") = "total");
+}
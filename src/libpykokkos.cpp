@@ -93,10 +93,12 @@ PYBIND11_MODULE(libpykokkos, kokkos) {
   auto _finalize = []() {
     if (!Kokkos::is_initialized()) return false;
     if (debug_output()) std::cerr << "Finalizing Kokkos..." << std::endl;
+    finalize_async();
     destroy_callbacks();
     Kokkos::Tools::Experimental::set_deallocate_data_callback(nullptr);
     py::module gc = py::module::import("gc");
     gc.attr("collect")();
+    finalize_view_cache();
     Kokkos::finalize();
     return true;
   };
@@ -110,12 +112,46 @@ PYBIND11_MODULE(libpykokkos, kokkos) {
   kokkos.def("finalize", _finalize, "Finalize Kokkos");
 
   generate_tools(kokkos);
+  generate_async(kokkos);
+  generate_view_cache(kokkos);
   generate_available(kokkos);
   generate_enumeration(kokkos);
   generate_view_variants(kokkos);
+  generate_view_factory(kokkos);
+  generate_mapped_file(kokkos);
+  generate_view_io(kokkos);
   generate_atomic_variants(kokkos);
+  generate_dual_view_variants(kokkos);
+  generate_unordered_map_variants(kokkos);
+  generate_scatter_view_variants(kokkos);
+  generate_bitset_variants(kokkos);
+  generate_growable_view_variants(kokkos);
+  generate_offset_view_variants(kokkos);
+  generate_crs_matrix_variants(kokkos);
   generate_backend_versions(kokkos);
   generate_pool_variants(kokkos);
   generate_execution_spaces(kokkos);
   generate_complex_dtypes(kokkos);
+
+  // lazy registration of the view and atomic classes (PEP 562)
+  kokkos.def("lazy_registration", &lazy_registration,
+             "Whether the view and atomic classes are created on first access "
+             "(PYKOKKOS_BASE_LAZY_REGISTRATION environment variable)");
+  kokkos.def(
+      "register_all",
+      [kokkos]() mutable { return register_all_pyclasses(kokkos); },
+      "Create every view and atomic class whose creation was deferred. "
+      "Returns the number of classes created");
+  kokkos.def("get_deferred_names", &get_lazy_pyclass_names,
+             "Names of the view and atomic classes which have not been "
+             "created yet");
+  kokkos.def(
+      "__getattr__",
+      [kokkos](const std::string& _name) mutable -> py::object {
+        if (!register_lazy_pyclass(kokkos, _name))
+          throw py::attribute_error("module 'libpykokkos' has no attribute '" +
+                                    _name + "'");
+        return kokkos.attr(_name.c_str());
+      },
+      "Creates deferred view and atomic classes on first access");
 }
@@ -0,0 +1,246 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <cerrno>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+#include "common.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+//----------------------------------------------------------------------------//
+//
+//                  Memory-mapped files for unmanaged host views
+//
+//----------------------------------------------------------------------------//
+//
+//  The mapping implements the buffer protocol so that it is passed to the
+//  unmanaged constructor of the HostSpace view classes, which keep the
+//  mapping alive. The file is unmapped when the last view (and the mapping
+//  object itself) is released.
+//
+namespace {
+#if defined(__unix__) || defined(__APPLE__)
+std::string get_error(const std::string& _msg, const std::string& _path) {
+  return "Error! " + _msg + " '" + _path + "': " + std::strerror(errno);
+}
+
+class mapped_file {
+ public:
+  // "r" maps the file copy-on-write so the file is never modified, "r+"
+  // maps the file shared and "w+" creates or truncates the file to the
+  // offset plus the length before mapping it shared
+  mapped_file(std::string _path, std::string _mode, size_t _offset,
+              std::optional<size_t> _length)
+      : m_path{std::move(_path)}, m_mode{std::move(_mode)}, m_offset{_offset} {
+    int _flags = 0;
+    if (m_mode == "r")
+      _flags = O_RDONLY;
+    else if (m_mode == "r+")
+      _flags = O_RDWR;
+    else if (m_mode == "w+")
+      _flags = O_RDWR | O_CREAT | O_TRUNC;
+    else
+      throw py::value_error("Error! Mode '" + m_mode +
+                            "' is not one of 'r', 'r+', or 'w+'");
+
+    if (m_mode == "w+" && !_length)
+      throw py::value_error("Error! Mode 'w+' requires a length");
+
+    int _fd = ::open(m_path.c_str(), _flags, 0644);
+    if (_fd < 0) throw std::runtime_error(get_error("Unable to open", m_path));
+
+    // mapping beyond the end of the file raises SIGBUS on access so the
+    // region is checked against the size of the file
+    struct stat _stat {};
+    size_t _file_size = 0;
+    if (m_mode == "w+") {
+      if (::ftruncate(_fd, static_cast<off_t>(m_offset + *_length)) != 0) {
+        ::close(_fd);
+        throw std::runtime_error(get_error("Unable to resize", m_path));
+      }
+      _file_size = m_offset + *_length;
+    } else if (::fstat(_fd, &_stat) == 0) {
+      _file_size = static_cast<size_t>(_stat.st_size);
+    }
+
+    m_size = (_length) ? *_length
+                       : ((m_offset < _file_size) ? _file_size - m_offset : 0);
+    if (m_size == 0 || m_offset + m_size > _file_size) {
+      ::close(_fd);
+      throw py::value_error("Error! The region [" + std::to_string(m_offset) +
+                            ", " + std::to_string(m_offset + m_size) +
+                            ") is empty or exceeds the size of '" + m_path +
+                            "' (" + std::to_string(_file_size) + " bytes)");
+    }
+
+    // the offset of a mapping must be a multiple of the page size
+    auto _page    = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    auto _aligned = m_offset - (m_offset % _page);
+    m_delta       = m_offset - _aligned;
+    m_length      = m_size + m_delta;
+
+    m_addr = ::mmap(nullptr, m_length, PROT_READ | PROT_WRITE,
+                    (m_mode == "r") ? MAP_PRIVATE : MAP_SHARED, _fd,
+                    static_cast<off_t>(_aligned));
+    // the mapping does not need the file descriptor
+    ::close(_fd);
+    if (m_addr == MAP_FAILED) {
+      m_addr = nullptr;
+      throw std::runtime_error(get_error("Unable to map", m_path));
+    }
+  }
+
+  ~mapped_file() {
+    if (m_addr) ::munmap(m_addr, m_length);
+  }
+
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+
+  void* data() const { return static_cast<char*>(m_addr) + m_delta; }
+  size_t size() const { return m_size; }
+  size_t offset() const { return m_offset; }
+  const std::string& path() const { return m_path; }
+  const std::string& mode() const { return m_mode; }
+
+  void advise(const std::string& _advice) {
+    int _value = MADV_NORMAL;
+    if (_advice == "normal")
+      _value = MADV_NORMAL;
+    else if (_advice == "sequential")
+      _value = MADV_SEQUENTIAL;
+    else if (_advice == "random")
+      _value = MADV_RANDOM;
+    else if (_advice == "willneed")
+      _value = MADV_WILLNEED;
+    else if (_advice == "dontneed")
+      _value = MADV_DONTNEED;
+    else
+      throw py::value_error("Error! Unknown advice '" + _advice +
+                            "'. Expected one of 'normal', 'sequential', "
+                            "'random', 'willneed', or 'dontneed'");
+    if (::madvise(m_addr, m_length, _value) != 0)
+      throw std::runtime_error(get_error("Unable to advise", m_path));
+  }
+
+  // writes the modified pages back to the file
+  void flush() {
+    if (m_mode == "r") return;
+    if (::msync(m_addr, m_length, MS_SYNC) != 0)
+      throw std::runtime_error(get_error("Unable to flush", m_path));
+  }
+
+ private:
+  std::string m_path;
+  std::string m_mode;
+  size_t m_offset = 0;
+  size_t m_size   = 0;
+  size_t m_delta  = 0;
+  size_t m_length = 0;
+  void* m_addr    = nullptr;
+};
+#else
+class mapped_file {
+ public:
+  mapped_file(std::string, std::string, size_t, std::optional<size_t>) {
+    throw std::runtime_error(
+        "Error! Memory-mapped files are not supported on this platform");
+  }
+
+  void* data() const { return nullptr; }
+  size_t size() const { return 0; }
+  size_t offset() const { return 0; }
+  const std::string& path() const { return m_path; }
+  const std::string& mode() const { return m_path; }
+  void advise(const std::string&) {}
+  void flush() {}
+
+ private:
+  std::string m_path;
+};
+#endif
+}  // namespace
+
+void generate_mapped_file(py::module& kokkos) {
+  py::class_<mapped_file> _mapped(
+      kokkos, "MappedFile", py::buffer_protocol(),
+      "Memory-mapped region of a file. Pass it as the array of an unmanaged "
+      "HostSpace view (see kokkos.map_file), the view keeps it mapped");
+
+  _mapped.def(py::init<std::string, std::string, size_t,
+                       std::optional<size_t>>(),
+              "Map the bytes [offset, offset + length) of the file. The "
+              "default length is the remainder of the file",
+              py::arg("path"), py::arg("mode") = "r", py::arg("offset") = 0,
+              py::arg("length") = py::none());
+
+  _mapped.def_buffer([](mapped_file& _m) -> py::buffer_info {
+    return py::buffer_info(_m.data(), sizeof(uint8_t),
+                           py::format_descriptor<uint8_t>::format(), 1,
+                           {_m.size()}, {sizeof(uint8_t)});
+  });
+
+  _mapped.def("advise", &mapped_file::advise,
+              "madvise hint for the access pattern: 'normal', 'sequential', "
+              "'random', 'willneed', or 'dontneed'",
+              py::arg("advice"));
+  _mapped.def("flush", &mapped_file::flush,
+              "Write the modified pages back to the file (msync)");
+
+  _mapped.def_property_readonly("path", &mapped_file::path, "Mapped file");
+  _mapped.def_property_readonly("mode", &mapped_file::mode, "Mapping mode");
+  _mapped.def_property_readonly("offset", &mapped_file::offset,
+                                "Offset of the region in the file (bytes)");
+  _mapped.def_property_readonly("size", &mapped_file::size,
+                                "Size of the region (bytes)");
+}
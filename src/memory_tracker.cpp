@@ -0,0 +1,193 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "common.hpp"
+#include "tools.hpp"
+
+//----------------------------------------------------------------------------//
+//
+//        Memory usage accounting per memory space and per view label
+//
+//----------------------------------------------------------------------------//
+
+namespace {
+struct memory_usage {
+  int64_t current        = 0;
+  int64_t peak           = 0;
+  uint64_t allocations   = 0;
+  uint64_t deallocations = 0;
+
+  void allocate(uint64_t _size) {
+    current += _size;
+    peak     = std::max(peak, current);
+    ++allocations;
+  }
+
+  void deallocate(uint64_t _size) {
+    current -= _size;
+    ++deallocations;
+  }
+
+  py::dict as_dict() const {
+    py::dict _value{};
+    _value["current"]       = current;
+    _value["peak"]          = peak;
+    _value["allocations"]   = allocations;
+    _value["deallocations"] = deallocations;
+    return _value;
+  }
+};
+
+class memory_tracker : public pykokkos_tools::native_tool {
+ public:
+  static memory_tracker& instance() {
+    return pykokkos_tools::leaked_instance<memory_tracker>();
+  }
+
+  void allocate_data(const space_handle_t& _space, const char* _label,
+                     const void* _ptr, uint64_t _size) override {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    auto& _spc = m_spaces[_space.name];
+    auto& _lbl = m_labels[_label];
+    _spc.allocate(_size);
+    _lbl.allocate(_size);
+    m_allocations[_ptr] = allocation{&_spc, &_lbl, _size};
+  }
+
+  void deallocate_data(const space_handle_t&, const char*, const void* _ptr,
+                       uint64_t) override {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    // ignore the allocations which happened before the tracker was installed
+    auto itr = m_allocations.find(_ptr);
+    if (itr == m_allocations.end()) return;
+    itr->second.space->deallocate(itr->second.size);
+    itr->second.label->deallocate(itr->second.size);
+    m_allocations.erase(itr);
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    m_allocations.clear();
+    m_spaces.clear();
+    m_labels.clear();
+  }
+
+  void reset_peak() {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    for (auto& itr : m_spaces) itr.second.peak = itr.second.current;
+    for (auto& itr : m_labels) itr.second.peak = itr.second.current;
+  }
+
+  py::dict snapshot() {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    py::dict _spaces{};
+    py::dict _labels{};
+    for (const auto& itr : m_spaces)
+      _spaces[itr.first.c_str()] = itr.second.as_dict();
+    for (const auto& itr : m_labels)
+      _labels[itr.first.c_str()] = itr.second.as_dict();
+    py::dict _value{};
+    _value["spaces"] = _spaces;
+    _value["labels"] = _labels;
+    return _value;
+  }
+
+ private:
+  struct allocation {
+    memory_usage* space;
+    memory_usage* label;
+    uint64_t size;
+  };
+
+  std::mutex m_mutex                                        = {};
+  std::unordered_map<const void*, allocation> m_allocations = {};
+  std::unordered_map<std::string, memory_usage> m_spaces    = {};
+  std::unordered_map<std::string, memory_usage> m_labels    = {};
+};
+}  // namespace
+
+void generate_memory_tracker(py::module& tools) {
+  auto _tracker = tools.def_submodule(
+      "memory_tracker",
+      "Native tracking of the current and peak memory usage per memory space "
+      "and per view label");
+
+  _tracker.def(
+      "install",
+      []() {
+        auto* _tool = &memory_tracker::instance();
+        if (pykokkos_tools::has_native_tool(_tool)) return;
+        _tool->clear();
+        pykokkos_tools::add_native_tool(_tool,
+                                        pykokkos_tools::AllocationEvents);
+      },
+      "Start tracking the allocations and deallocations");
+
+  _tracker.def(
+      "uninstall",
+      []() { pykokkos_tools::remove_native_tool(&memory_tracker::instance()); },
+      "Stop tracking the allocations and deallocations");
+
+  _tracker.def(
+      "installed",
+      []() {
+        return pykokkos_tools::has_native_tool(&memory_tracker::instance());
+      },
+      "Whether the memory tracker is installed");
+
+  _tracker.def(
+      "snapshot", []() { return memory_tracker::instance().snapshot(); },
+      "Returns {'spaces': {...}, 'labels': {...}} where each entry maps the "
+      "memory space (or label) to the current and peak bytes and the number of "
+      "allocations and deallocations");
+
+  _tracker.def(
+      "reset_peak", []() { memory_tracker::instance().reset_peak(); },
+      "Reset the peak bytes to the current bytes");
+}
@@ -0,0 +1,348 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <array>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common.hpp"
+#include "tools.hpp"
+
+#if defined(__linux__)
+#  include <dirent.h>
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+//----------------------------------------------------------------------------//
+//
+//        Hardware performance counters per kernel name (Linux only)
+//
+//----------------------------------------------------------------------------//
+
+namespace {
+constexpr size_t num_counters = 4;
+
+const char* get_counter_name(size_t _idx) {
+  static const char* _names[num_counters] = {"cycles", "instructions",
+                                             "llc_misses", "branch_misses"};
+  return _names[_idx];
+}
+
+using counter_values_t = std::array<uint64_t, num_counters>;
+
+struct kernel_counters {
+  uint64_t count            = 0;
+  counter_values_t counters = {};
+};
+
+#if defined(__linux__)
+// the counters of every thread of the process when the tool is installed,
+// i.e. including the OpenMP/Threads workers. Counters for a thread are
+// opened as a group so that they are read with a single syscall
+class perf_counters : public pykokkos_tools::native_tool {
+ public:
+  static perf_counters& instance() {
+    return pykokkos_tools::leaked_instance<perf_counters>();
+  }
+
+  static constexpr bool available() { return true; }
+
+  void begin_kernel(const pykokkos_tools::kernel_event&) override {
+    auto& _frame = get_frames();
+    _frame.emplace_back(read());
+  }
+
+  void end_kernel(const pykokkos_tools::kernel_event& _event) override {
+    auto& _frame = get_frames();
+    if (_frame.empty()) return;
+    auto _end   = read();
+    auto _begin = _frame.back();
+    _frame.pop_back();
+
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    auto& _entry = m_kernels[_event.name];
+    ++_entry.count;
+    for (size_t i = 0; i < num_counters; ++i)
+      _entry.counters[i] += _end[i] - _begin[i];
+  }
+
+  void open() {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    close_impl();
+    m_kernels.clear();
+
+    static const std::array<std::pair<uint32_t, uint64_t>, num_counters>
+        _configs = {
+            std::make_pair(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES),
+            std::make_pair(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS),
+            std::make_pair(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES),
+            std::make_pair(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES)};
+
+    m_supported.fill(false);
+    std::string _error{};
+    for (auto _tid : get_thread_ids()) {
+      auto _group = counter_group{};
+      for (size_t i = 0; i < num_counters; ++i) {
+        // unsupported on the first thread => skipped on the others
+        if (!m_threads.empty() && !m_supported.at(i)) continue;
+        perf_event_attr _attr{};
+        _attr.size           = sizeof(_attr);
+        _attr.type           = _configs.at(i).first;
+        _attr.config         = _configs.at(i).second;
+        _attr.exclude_kernel = 1;
+        _attr.exclude_hv     = 1;
+        _attr.read_format    = PERF_FORMAT_GROUP;
+        auto _fd             = syscall(__NR_perf_event_open, &_attr, _tid, -1,
+                                       _group.leader(), 0);
+        if (_fd < 0) {
+          if (_error.empty()) _error = strerror(errno);
+          continue;
+        }
+        if (m_threads.empty()) m_supported.at(i) = true;
+        _group.fds.emplace_back(static_cast<int>(_fd));
+      }
+      // the thread may have exited since the directory was listed. The values
+      // of a group are read in order so it must contain every counter
+      size_t _expected = 0;
+      for (auto itr : m_supported) _expected += (itr) ? 1 : 0;
+      if (!_group.fds.empty() && _group.fds.size() == _expected) {
+        m_threads.emplace_back(std::move(_group));
+      } else {
+        for (auto itr : _group.fds) ::close(itr);
+      }
+    }
+
+    if (m_threads.empty()) {
+      throw std::runtime_error(
+          "Error! perf_event_open failed: " + _error +
+          ". Check /proc/sys/kernel/perf_event_paranoid");
+    }
+  }
+
+  void close() {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    close_impl();
+  }
+
+  std::vector<std::string> events() {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    std::vector<std::string> _value{};
+    for (size_t i = 0; i < num_counters; ++i) {
+      if (m_supported.at(i)) _value.emplace_back(get_counter_name(i));
+    }
+    return _value;
+  }
+
+  std::unordered_map<std::string, kernel_counters> results() {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    return m_kernels;
+  }
+
+  std::array<bool, num_counters> supported() {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    return m_supported;
+  }
+
+  void reset() {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    m_kernels.clear();
+  }
+
+ private:
+  struct counter_group {
+    std::vector<int> fds = {};
+
+    int leader() const { return (fds.empty()) ? -1 : fds.front(); }
+  };
+
+  static std::vector<pid_t> get_thread_ids() {
+    std::vector<pid_t> _value{};
+    if (auto* _dir = opendir("/proc/self/task")) {
+      while (auto* _entry = readdir(_dir)) {
+        if (_entry->d_name[0] == '.') continue;
+        _value.emplace_back(static_cast<pid_t>(atoi(_entry->d_name)));
+      }
+      closedir(_dir);
+    }
+    return _value;
+  }
+
+  static std::vector<counter_values_t>& get_frames() {
+    static thread_local std::vector<counter_values_t> _value{};
+    return _value;
+  }
+
+  // sum of the counters over the threads
+  counter_values_t read() {
+    counter_values_t _value{};
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    // { nr, values[nr] }
+    uint64_t _buffer[num_counters + 1];
+    for (const auto& itr : m_threads) {
+      auto _bytes = ::read(itr.leader(), _buffer, sizeof(_buffer));
+      if (_bytes < static_cast<ssize_t>(sizeof(uint64_t))) continue;
+      // the values are in the order of the supported counters
+      size_t _n = 0;
+      for (size_t i = 0; i < num_counters && _n < _buffer[0]; ++i) {
+        if (m_supported.at(i)) _value.at(i) += _buffer[1 + _n++];
+      }
+    }
+    return _value;
+  }
+
+  void close_impl() {
+    for (auto& itr : m_threads) {
+      // close the members before the leader
+      for (auto fitr = itr.fds.rbegin(); fitr != itr.fds.rend(); ++fitr)
+        ::close(*fitr);
+    }
+    m_threads.clear();
+  }
+
+  std::mutex m_mutex                                         = {};
+  std::array<bool, num_counters> m_supported                 = {};
+  std::vector<counter_group> m_threads                       = {};
+  std::unordered_map<std::string, kernel_counters> m_kernels = {};
+};
+#else
+class perf_counters : public pykokkos_tools::native_tool {
+ public:
+  static perf_counters& instance() {
+    return pykokkos_tools::leaked_instance<perf_counters>();
+  }
+
+  static constexpr bool available() { return false; }
+
+  void open() {
+    throw std::runtime_error(
+        "Error! hardware performance counters require Linux perf_event_open");
+  }
+
+  void close() {}
+  void reset() {}
+  std::vector<std::string> events() { return {}; }
+  std::unordered_map<std::string, kernel_counters> results() { return {}; }
+  std::array<bool, num_counters> supported() { return {}; }
+};
+#endif
+}  // namespace
+
+void generate_perf_counters(py::module& tools) {
+  auto _perf = tools.def_submodule(
+      "perf_counters",
+      "Hardware performance counters (cycles, instructions, LLC misses, branch "
+      "misses) per kernel name via Linux perf_event_open");
+
+  _perf.def(
+      "available", []() { return perf_counters::available(); },
+      "Whether perf_event_open is supported on this platform");
+
+  _perf.def(
+      "install",
+      []() {
+        auto* _tool = &perf_counters::instance();
+        if (pykokkos_tools::has_native_tool(_tool)) return;
+        _tool->open();
+        pykokkos_tools::add_native_tool(_tool, pykokkos_tools::KernelEvents);
+      },
+      "Open the counters for every thread of the process and start "
+      "attributing them to the kernels. Threads created afterwards are not "
+      "counted. Raises RuntimeError if the counters cannot be opened, e.g. "
+      "due to /proc/sys/kernel/perf_event_paranoid");
+
+  _perf.def(
+      "uninstall",
+      []() {
+        auto* _tool = &perf_counters::instance();
+        pykokkos_tools::remove_native_tool(_tool);
+        _tool->close();
+      },
+      "Stop counting and close the counters. The results are retained");
+
+  _perf.def(
+      "installed",
+      []() {
+        return pykokkos_tools::has_native_tool(&perf_counters::instance());
+      },
+      "Whether the counters are installed");
+
+  _perf.def(
+      "events", []() { return perf_counters::instance().events(); },
+      "The counters which are supported by the hardware (or hypervisor)");
+
+  _perf.def(
+      "reset", []() { perf_counters::instance().reset(); },
+      "Discard the accumulated counts");
+
+  _perf.def(
+      "results",
+      []() {
+        auto _supported = perf_counters::instance().supported();
+        py::dict _value{};
+        for (const auto& itr : perf_counters::instance().results()) {
+          py::dict _entry{};
+          _entry["count"] = itr.second.count;
+          for (size_t i = 0; i < num_counters; ++i) {
+            if (_supported.at(i))
+              _entry[get_counter_name(i)] = itr.second.counters.at(i);
+          }
+          // instructions per cycle: low values suggest memory-bound kernels
+          if (_supported.at(0) && _supported.at(1) && itr.second.counters[0])
+            _entry["ipc"] = static_cast<double>(itr.second.counters[1]) /
+                            itr.second.counters[0];
+          _value[itr.first.c_str()] = _entry;
+        }
+        return _value;
+      },
+      "Returns {kernel name: {'count', 'cycles', 'instructions', 'llc_misses', "
+      "'branch_misses', 'ipc'}} for the supported counters");
+}
@@ -0,0 +1,181 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <string>
+
+#include "common.hpp"
+#include "tools.hpp"
+
+//----------------------------------------------------------------------------//
+//
+//        Region and profile section context managers and decorators
+//
+//----------------------------------------------------------------------------//
+
+namespace {
+// the name is stored once so entering the region does not create a string
+class profile_region {
+ public:
+  explicit profile_region(std::string _name) : m_name{std::move(_name)} {}
+
+  const std::string& name() const { return m_name; }
+  void start() const { Kokkos::Tools::pushRegion(m_name); }
+  void stop() const { Kokkos::Tools::popRegion(); }
+
+ private:
+  std::string m_name = {};
+};
+
+// the section is created once and destroyed with the object
+class profile_section {
+ public:
+  explicit profile_section(std::string _name) : m_name{std::move(_name)} {
+    Kokkos::Tools::createProfileSection(m_name, &m_id);
+  }
+
+  ~profile_section() {
+    if (!Kokkos::is_finalized()) Kokkos::Tools::destroyProfileSection(m_id);
+  }
+
+  profile_section(const profile_section&)            = delete;
+  profile_section& operator=(const profile_section&) = delete;
+
+  const std::string& name() const { return m_name; }
+  uint32_t id() const { return m_id; }
+  void start() const { Kokkos::Tools::startSection(m_id); }
+  void stop() const { Kokkos::Tools::stopSection(m_id); }
+
+ private:
+  std::string m_name = {};
+  uint32_t m_id      = 0;
+};
+
+template <typename ScopeT>
+struct scope_guard {
+  explicit scope_guard(const ScopeT& _scope) : m_scope{_scope} {
+    m_scope.start();
+  }
+  ~scope_guard() { m_scope.stop(); }
+
+ private:
+  const ScopeT& m_scope;
+};
+
+// the function returned by the decorators. It keeps a reference to the
+// region (or section) and supports binding as a method
+template <typename ScopeT>
+struct scoped_function {
+  py::object scope    = {};
+  py::function func   = {};
+  const ScopeT* value = nullptr;
+
+  py::object operator()(py::args _args, py::kwargs _kwargs) const {
+    scope_guard<ScopeT> _guard{*value};
+    return func(*_args, **_kwargs);
+  }
+};
+
+template <typename ScopeT>
+auto generate_scope(py::module& _tools, const char* _name,
+                    const char* _function_name, const char* _doc) {
+  using function_t = scoped_function<ScopeT>;
+
+  py::class_<function_t> _function(_tools, _function_name, py::dynamic_attr(),
+                                   "Function decorated with a region or "
+                                   "profile section");
+  _function.def("__call__", &function_t::operator());
+  _function.def(
+      "__get__",
+      [](py::object _self, py::object _obj, py::object) -> py::object {
+        if (_obj.is_none()) return _self;
+        return py::module::import("types").attr("MethodType")(_self, _obj);
+      },
+      py::arg("obj"), py::arg("type") = py::none{});
+
+  py::class_<ScopeT, std::unique_ptr<ScopeT>> _scope(_tools, _name, _doc);
+  _scope.def(py::init<std::string>(), py::arg("name"));
+  _scope.def_property_readonly("name", &ScopeT::name);
+  _scope.def("start", &ScopeT::start, "Enter the region (or section)");
+  _scope.def("stop", &ScopeT::stop, "Exit the region (or section)");
+  _scope.def(
+      "__enter__",
+      [](py::object _self) {
+        _self.cast<const ScopeT&>().start();
+        return _self;
+      },
+      "Enter the region (or section)");
+  _scope.def(
+      "__exit__",
+      [](const ScopeT& _self, py::args) {
+        _self.stop();
+        return false;
+      },
+      "Exit the region (or section)");
+  _scope.def(
+      "__call__",
+      [](py::object _self, py::function _func) {
+        auto _wrapper = py::cast(
+            function_t{_self, _func, &_self.cast<const ScopeT&>()});
+        py::module::import("functools").attr("update_wrapper")(_wrapper, _func);
+        return _wrapper;
+      },
+      "Decorate a function so that every call is within the region (or "
+      "section)",
+      py::arg("func"));
+  return _scope;
+}
+}  // namespace
+
+void generate_regions(py::module& tools) {
+  generate_scope<profile_region>(
+      tools, "Region", "_RegionFunction",
+      "Region which can be used as a context manager or decorator. The name "
+      "is converted once so entering the region is cheap in hot loops");
+
+  auto _section = generate_scope<profile_section>(
+      tools, "ProfileSection", "_ProfileSectionFunction",
+      "Profile section which can be used as a context manager or decorator. "
+      "The section is created once and destroyed with the object");
+  _section.def_property_readonly("id", &profile_section::id, "Section id");
+}
@@ -42,7 +42,15 @@
 //@HEADER
 */
 
+#include "tools.hpp"
+
 #include <Kokkos_Core.hpp>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "common.hpp"
 #include "defines.hpp"
@@ -55,9 +63,6 @@
 //
 //----------------------------------------------------------------------------//
 
-using device_info_t  = struct Kokkos_Profiling_KokkosPDeviceInfo;
-using space_handle_t = struct Kokkos_Profiling_SpaceHandle;
-
 using initFunction     = std::function<void(const int, const uint64_t,
                                         const uint32_t, device_info_t*)>;
 using finalizeFunction = std::function<void()>;
@@ -84,13 +89,16 @@ using endDeepCopyFunction = std::function<void()>;
 using beginFenceFunction = std::function<uint64_t(const char*, const uint32_t)>;
 using endFenceFunction   = std::function<void(uint64_t)>;
 
+// the python callbacks acquire the GIL because kokkos also emits events from
+// the kernels launched with the GIL released and from the future waiter thread
 template <typename Ret, typename... Args>
 auto pyfunction_wrapper(std::function<Ret(Args...)>& _cb, py::object _func,
                         std::enable_if_t<!std::is_void<Ret>::value, int> = 0) {
   if (_func.is_none()) {
-    _cb = [](Args...) -> Ret { return Ret{}; };
+    _cb = nullptr;
   } else {
     _cb = [_func](Args... args) -> Ret {
+      py::gil_scoped_acquire _gil{};
       return _func(args...).template cast<Ret>();
     };
   }
@@ -100,30 +108,20 @@ template <typename Ret, typename... Args>
 auto pyfunction_wrapper(std::function<Ret(Args...)>& _cb, py::object _func,
                         std::enable_if_t<std::is_void<Ret>::value, long> = 0) {
   if (_func.is_none()) {
-    _cb = [](Args...) {};
+    _cb = nullptr;
   } else {
-    _cb = [_func](Args... args) { _func(args...); };
+    _cb = [_func](Args... args) {
+      py::gil_scoped_acquire _gil{};
+      _func(args...);
+    };
   }
 }
 
+// unset callbacks are left empty so the trampolines can skip them
 template <typename Ret, typename... Args>
 auto cppfunction_wrapper(std::function<Ret(Args...)>& _cb,
-                         std::function<Ret(Args...)> _func,
-                         std::enable_if_t<!std::is_void<Ret>::value, int> = 0) {
-  if (_func)
-    _cb = std::move(_func);
-  else
-    _cb = [](Args...) -> Ret { return Ret{}; };
-}
-
-template <typename Ret, typename... Args>
-auto cppfunction_wrapper(std::function<Ret(Args...)>& _cb,
-                         std::function<Ret(Args...)> _func,
-                         std::enable_if_t<std::is_void<Ret>::value, long> = 0) {
-  if (_func)
-    _cb = std::move(_func);
-  else
-    _cb = [](Args...) {};
+                         std::function<Ret(Args...)> _func) {
+  _cb = std::move(_func);
 }
 
 namespace {
@@ -162,6 +160,222 @@ struct internal_callbacks {
 //
 static auto callbacks = std::make_unique<internal_callbacks>();
 //
+namespace {
+// tools implemented in C++ which are invoked by the trampolines below
+struct native_tool_entry {
+  std::atomic<pykokkos_tools::native_tool*> tool = {nullptr};
+  std::atomic<uint32_t> events                   = {0};
+};
+
+auto& get_native_tools() {
+  static std::array<native_tool_entry, 16> _value{};
+  return _value;
+}
+
+// union of the events of all the native tools
+std::atomic<uint32_t> native_events = {0};
+
+template <typename FuncT>
+inline void dispatch_native(pykokkos_tools::native_event _event,
+                            FuncT&& _func) {
+  if ((native_events.load(std::memory_order_relaxed) & _event) == 0) return;
+  for (auto& itr : get_native_tools()) {
+    if ((itr.events.load(std::memory_order_acquire) & _event) == 0) continue;
+    auto* _tool = itr.tool.load(std::memory_order_acquire);
+    if (_tool) _func(_tool);
+  }
+}
+
+inline bool native_enabled(uint32_t _events) {
+  return (native_events.load(std::memory_order_relaxed) & _events) != 0;
+}
+
+// the popped frames retain their storage so their strings do not reallocate.
+// The begin events without a native tool push a placeholder when nested in a
+// recorded frame, so the end events stay paired with their begin events when
+// a tool is enabled (or disabled) mid-nesting
+template <typename Tp>
+struct frame_stack {
+  Tp& push() { return push(true); }
+
+  void skip() {
+    if (m_size > 0) push(false);
+  }
+
+  // nullptr for an end event without a recorded begin event
+  Tp* pop() {
+    if (m_size == 0) return nullptr;
+    --m_size;
+    return (m_recorded[m_size]) ? &m_data[m_size] : nullptr;
+  }
+
+ private:
+  Tp& push(bool _recorded) {
+    if (m_size == m_data.size()) {
+      m_data.emplace_back();
+      m_recorded.emplace_back(false);
+    }
+    m_recorded[m_size] = _recorded;
+    return m_data[m_size++];
+  }
+
+  size_t m_size                = 0;
+  std::vector<Tp> m_data       = {};
+  std::vector<bool> m_recorded = {};
+};
+
+struct kernel_frame {
+  std::string name                 = {};
+  uint32_t device                  = 0;
+  pykokkos_tools::kernel_kind kind = pykokkos_tools::ParallelFor;
+  uint64_t begin                   = 0;
+};
+
+struct region_frame {
+  std::string name = {};
+  uint64_t begin   = 0;
+};
+
+struct deep_copy_frame {
+  std::string dst_space = {};
+  std::string dst_label = {};
+  std::string src_space = {};
+  std::string src_label = {};
+  const void* dst_ptr   = nullptr;
+  const void* src_ptr   = nullptr;
+  uint64_t size         = 0;
+  uint64_t begin        = 0;
+};
+
+struct section_info {
+  std::string name = {};
+  uint64_t begin   = 0;
+};
+
+thread_local frame_stack<kernel_frame> kernel_frames       = {};
+thread_local frame_stack<region_frame> region_frames       = {};
+thread_local frame_stack<deep_copy_frame> deep_copy_frames = {};
+
+std::mutex section_mutex                                    = {};
+std::unordered_map<uint32_t, section_info> section_info_map = {};
+std::atomic<uint32_t> section_count                         = {0};
+
+// sampling of the python (and C++) callbacks. The native tools always receive
+// every event. Kernels and fences are sampled every Nth launch per name and
+// all the sampled callbacks share a budget of time per second
+struct sampling_policy {
+  std::atomic<uint64_t> every      = {1};
+  std::atomic<uint64_t> budget     = {0};  // ns per second, zero is unlimited
+  std::atomic<uint64_t> window     = {0};
+  std::atomic<uint64_t> spent      = {0};
+  std::atomic<uint64_t> sampled    = {0};
+  std::atomic<uint64_t> skipped    = {0};
+  std::atomic<uint64_t> generation = {0};  // restarts the launch counts
+};
+
+sampling_policy sampling = {};
+
+// the decisions of the begin events so that the end events match
+thread_local std::vector<bool> kernel_samples    = {};
+thread_local std::vector<bool> region_samples    = {};
+thread_local std::vector<bool> deep_copy_samples = {};
+
+bool within_budget() {
+  auto _budget = sampling.budget.load(std::memory_order_relaxed);
+  if (_budget == 0) return true;
+  auto _now    = pykokkos_tools::get_timestamp();
+  auto _window = sampling.window.load(std::memory_order_relaxed);
+  if (_now - _window >= 1000000000) {
+    sampling.window.store(_now, std::memory_order_relaxed);
+    sampling.spent.store(0, std::memory_order_relaxed);
+  }
+  return sampling.spent.load(std::memory_order_relaxed) < _budget;
+}
+
+// a null name is only subject to the time budget
+bool sample_instant(const char* _name = nullptr) {
+  auto _every = sampling.every.load(std::memory_order_relaxed);
+  bool _value = true;
+  if (_name && _every > 1) {
+    static thread_local std::unordered_map<std::string, uint64_t> _counts{};
+    static thread_local std::string _key{};
+    static thread_local uint64_t _generation = 0;
+    if (_generation != sampling.generation.load(std::memory_order_relaxed)) {
+      _generation = sampling.generation.load(std::memory_order_relaxed);
+      _counts.clear();
+    }
+    _key.assign(_name);
+    _value = (_counts[_key]++ % _every) == 0;
+  }
+  _value = _value && within_budget();
+  if (_value)
+    ++sampling.sampled;
+  else
+    ++sampling.skipped;
+  return _value;
+}
+
+// the callers check for a callback first so events without one are neither
+// sampled nor counted
+bool sample_begin(std::vector<bool>& _samples, const char* _name = nullptr) {
+  _samples.emplace_back(sample_instant(_name));
+  return _samples.back();
+}
+
+// _sampled is whether the begin event has a callback, i.e. whether
+// sample_begin recorded a decision. Without one, the end event is not sampled
+bool sample_end(std::vector<bool>& _samples, bool _sampled) {
+  if (!_sampled || _samples.empty()) return true;
+  bool _value = _samples.back();
+  _samples.pop_back();
+  return _value;
+}
+
+// accumulates the time spent in a callback towards the budget
+struct sampling_timer {
+  sampling_timer()
+      : m_begin{(sampling.budget.load(std::memory_order_relaxed) > 0)
+                    ? pykokkos_tools::get_timestamp()
+                    : 0} {}
+
+  ~sampling_timer() {
+    if (m_begin > 0)
+      sampling.spent.fetch_add(pykokkos_tools::get_timestamp() - m_begin,
+                               std::memory_order_relaxed);
+  }
+
+ private:
+  uint64_t m_begin = 0;
+};
+
+void native_begin_kernel(pykokkos_tools::native_event _event,
+                         pykokkos_tools::kernel_kind _kind, const char* _name,
+                         uint32_t _devid) {
+  if (!native_enabled(_event)) return kernel_frames.skip();
+  auto& _frame = kernel_frames.push();
+  _frame.name.assign(_name);
+  _frame.device = _devid;
+  _frame.kind   = _kind;
+  _frame.begin  = pykokkos_tools::get_timestamp();
+  auto _info    = pykokkos_tools::kernel_event{_frame.name.c_str(), _devid,
+                                            _kind, _frame.begin, 0};
+  dispatch_native(_event, [&_info](pykokkos_tools::native_tool* _tool) {
+    _tool->begin_kernel(_info);
+  });
+}
+
+void native_end_kernel(pykokkos_tools::native_event _event) {
+  auto _end    = pykokkos_tools::get_timestamp();
+  auto* _frame = kernel_frames.pop();
+  if (!_frame) return;
+  auto _info = pykokkos_tools::kernel_event{
+      _frame->name.c_str(), _frame->device, _frame->kind, _frame->begin, _end};
+  dispatch_native(_event, [&_info](pykokkos_tools::native_tool* _tool) {
+    _tool->end_kernel(_info);
+  });
+}
+}  // namespace
+//
 namespace pykokkos_tools {
 void print_help(char* argv) {
   if (callbacks && callbacks->print_help) callbacks->print_help(argv);
@@ -196,58 +410,118 @@ void finalize_library() {
 //----------------------------------------------------------------------------------//
 
 void begin_parallel_for(const char* name, uint32_t devid, uint64_t* kernid) {
-  if (callbacks && callbacks->begin_parallel[0])
+  if (callbacks && callbacks->begin_parallel[0] &&
+      sample_begin(kernel_samples, name)) {
+    sampling_timer _timer{};
     *kernid = callbacks->begin_parallel[0](name, devid);
+  }
+  native_begin_kernel(KernelEvents, ParallelFor, name, devid);
 }
 
 void end_parallel_for(uint64_t kernid) {
-  if (callbacks && callbacks->end_parallel[0])
+  native_end_kernel(KernelEvents);
+  if (callbacks &&
+      sample_end(kernel_samples, callbacks->begin_parallel[0] != nullptr) &&
+      callbacks->end_parallel[0]) {
+    sampling_timer _timer{};
     callbacks->end_parallel[0](kernid);
+  }
 }
 
 //----------------------------------------------------------------------------------//
 
 void begin_parallel_reduce(const char* name, uint32_t devid, uint64_t* kernid) {
-  if (callbacks && callbacks->begin_parallel[1])
+  if (callbacks && callbacks->begin_parallel[1] &&
+      sample_begin(kernel_samples, name)) {
+    sampling_timer _timer{};
     *kernid = callbacks->begin_parallel[1](name, devid);
+  }
+  native_begin_kernel(KernelEvents, ParallelReduce, name, devid);
 }
 
 void end_parallel_reduce(uint64_t kernid) {
-  if (callbacks && callbacks->end_parallel[1])
+  native_end_kernel(KernelEvents);
+  if (callbacks &&
+      sample_end(kernel_samples, callbacks->begin_parallel[1] != nullptr) &&
+      callbacks->end_parallel[1]) {
+    sampling_timer _timer{};
     callbacks->end_parallel[1](kernid);
+  }
 }
 
 //----------------------------------------------------------------------------------//
 
 void begin_parallel_scan(const char* name, uint32_t devid, uint64_t* kernid) {
-  if (callbacks && callbacks->begin_parallel[2])
+  if (callbacks && callbacks->begin_parallel[2] &&
+      sample_begin(kernel_samples, name)) {
+    sampling_timer _timer{};
     *kernid = callbacks->begin_parallel[2](name, devid);
+  }
+  native_begin_kernel(KernelEvents, ParallelScan, name, devid);
 }
 
 void end_parallel_scan(uint64_t kernid) {
-  if (callbacks && callbacks->end_parallel[2])
+  native_end_kernel(KernelEvents);
+  if (callbacks &&
+      sample_end(kernel_samples, callbacks->begin_parallel[2] != nullptr) &&
+      callbacks->end_parallel[2]) {
+    sampling_timer _timer{};
     callbacks->end_parallel[2](kernid);
+  }
 }
 
 //----------------------------------------------------------------------------------//
 
 void begin_fence(const char* name, uint32_t devid, uint64_t* kernid) {
-  if (callbacks && callbacks->begin_fence)
+  if (callbacks && callbacks->begin_fence &&
+      sample_begin(kernel_samples, name)) {
+    sampling_timer _timer{};
     *kernid = callbacks->begin_fence(name, devid);
+  }
+  native_begin_kernel(FenceEvents, Fence, name, devid);
 }
 
 void end_fence(uint64_t kernid) {
-  if (callbacks && callbacks->end_fence) callbacks->end_fence(kernid);
+  native_end_kernel(FenceEvents);
+  if (callbacks &&
+      sample_end(kernel_samples, callbacks->begin_fence != nullptr) &&
+      callbacks->end_fence) {
+    sampling_timer _timer{};
+    callbacks->end_fence(kernid);
+  }
 }
 
 //----------------------------------------------------------------------------------//
 
 void push_profile_region(const char* name) {
-  if (callbacks && callbacks->push) callbacks->push(name);
+  if (callbacks && callbacks->push && sample_begin(region_samples)) {
+    sampling_timer _timer{};
+    callbacks->push(name);
+  }
+  if (native_enabled(RegionEvents)) {
+    auto& _frame = region_frames.push();
+    _frame.name.assign(name);
+    _frame.begin = get_timestamp();
+    dispatch_native(RegionEvents, [&_frame](native_tool* _tool) {
+      _tool->push_region(_frame.name.c_str(), _frame.begin);
+    });
+  } else {
+    region_frames.skip();
+  }
 }
 
 void pop_profile_region() {
-  if (callbacks && callbacks->pop) callbacks->pop();
+  auto _end = get_timestamp();
+  if (auto* _frame = region_frames.pop()) {
+    dispatch_native(RegionEvents, [_frame, _end](native_tool* _tool) {
+      _tool->pop_region(_frame->name.c_str(), _frame->begin, _end);
+    });
+  }
+  if (callbacks && sample_end(region_samples, callbacks->push != nullptr) &&
+      callbacks->pop) {
+    sampling_timer _timer{};
+    callbacks->pop();
+  }
 }
 
 //----------------------------------------------------------------------------------//
@@ -255,19 +529,49 @@ void pop_profile_region() {
 void create_profile_section(const char* name, uint32_t* secid) {
   if (callbacks && callbacks->create_prof)
     *secid = callbacks->create_prof(name);
+  else
+    *secid = section_count++;
+  if (native_enabled(SectionEvents)) {
+    std::lock_guard<std::mutex> _lk{section_mutex};
+    section_info_map[*secid] = section_info{name, 0};
+  }
 }
 
 void destroy_profile_section(uint32_t secid) {
   if (callbacks && callbacks->destroy_prof) callbacks->destroy_prof(secid);
+  std::lock_guard<std::mutex> _lk{section_mutex};
+  section_info_map.erase(secid);
 }
 
 //----------------------------------------------------------------------------------//
 
 void start_profile_section(uint32_t secid) {
   if (callbacks && callbacks->start_prof) callbacks->start_prof(secid);
+  if (native_enabled(SectionEvents)) {
+    std::lock_guard<std::mutex> _lk{section_mutex};
+    auto itr = section_info_map.find(secid);
+    if (itr == section_info_map.end()) return;
+    itr->second.begin = get_timestamp();
+    dispatch_native(SectionEvents, [itr, secid](native_tool* _tool) {
+      _tool->start_section(itr->second.name.c_str(), secid, itr->second.begin);
+    });
+  }
 }
 
 void stop_profile_section(uint32_t secid) {
+  auto _end = get_timestamp();
+  if (native_enabled(SectionEvents)) {
+    std::lock_guard<std::mutex> _lk{section_mutex};
+    auto itr = section_info_map.find(secid);
+    // ignore the stop events of sections started before the tool was enabled
+    if (itr != section_info_map.end() && itr->second.begin > 0) {
+      dispatch_native(SectionEvents, [itr, secid, _end](native_tool* _tool) {
+        _tool->stop_section(itr->second.name.c_str(), secid,
+                            itr->second.begin, _end);
+      });
+      itr->second.begin = 0;
+    }
+  }
   if (callbacks && callbacks->stop_prof) callbacks->stop_prof(secid);
 }
 
@@ -275,14 +579,24 @@ void stop_profile_section(uint32_t secid) {
 
 void allocate_data(const space_handle_t space, const char* label,
                    const void* const ptr, const uint64_t size) {
-  if (callbacks && callbacks->alloc_data)
+  dispatch_native(AllocationEvents, [&](native_tool* _tool) {
+    _tool->allocate_data(space, label, ptr, size);
+  });
+  if (callbacks && callbacks->alloc_data && sample_instant()) {
+    sampling_timer _timer{};
     callbacks->alloc_data(space, label, ptr, size);
+  }
 }
 
 void deallocate_data(const space_handle_t space, const char* label,
                      const void* const ptr, const uint64_t size) {
-  if (callbacks && callbacks->dealloc_data)
+  dispatch_native(AllocationEvents, [&](native_tool* _tool) {
+    _tool->deallocate_data(space, label, ptr, size);
+  });
+  if (callbacks && callbacks->dealloc_data && sample_instant()) {
+    sampling_timer _timer{};
     callbacks->dealloc_data(space, label, ptr, size);
+  }
 }
 
 //----------------------------------------------------------------------------------//
@@ -290,19 +604,203 @@ void deallocate_data(const space_handle_t space, const char* label,
 void begin_deep_copy(space_handle_t dst_handle, const char* dst_name,
                      const void* dst_ptr, space_handle_t src_handle,
                      const char* src_name, const void* src_ptr, uint64_t size) {
-  if (callbacks && callbacks->begin_deep_copy)
+  if (callbacks && callbacks->begin_deep_copy &&
+      sample_begin(deep_copy_samples)) {
+    sampling_timer _timer{};
     callbacks->begin_deep_copy(dst_handle, dst_name, dst_ptr, src_handle,
                                src_name, src_ptr, size);
+  }
+  if (native_enabled(DeepCopyEvents)) {
+    auto& _frame = deep_copy_frames.push();
+    _frame.dst_space.assign(dst_handle.name);
+    _frame.dst_label.assign(dst_name);
+    _frame.src_space.assign(src_handle.name);
+    _frame.src_label.assign(src_name);
+    _frame.dst_ptr = dst_ptr;
+    _frame.src_ptr = src_ptr;
+    _frame.size    = size;
+    _frame.begin   = get_timestamp();
+    auto _info     = deep_copy_event{
+        _frame.dst_space.c_str(), _frame.dst_label.c_str(), dst_ptr,
+        _frame.src_space.c_str(), _frame.src_label.c_str(), src_ptr,
+        size,                     _frame.begin,             0};
+    dispatch_native(DeepCopyEvents, [&_info](native_tool* _tool) {
+      _tool->begin_deep_copy(_info);
+    });
+  } else {
+    deep_copy_frames.skip();
+  }
 }
 
 void end_deep_copy() {
-  if (callbacks && callbacks->end_deep_copy) callbacks->end_deep_copy();
+  auto _end = get_timestamp();
+  if (auto* _frame = deep_copy_frames.pop()) {
+    auto _info = deep_copy_event{
+        _frame->dst_space.c_str(), _frame->dst_label.c_str(), _frame->dst_ptr,
+        _frame->src_space.c_str(), _frame->src_label.c_str(), _frame->src_ptr,
+        _frame->size,              _frame->begin,             _end};
+    dispatch_native(DeepCopyEvents, [&_info](native_tool* _tool) {
+      _tool->end_deep_copy(_info);
+    });
+  }
+  if (callbacks &&
+      sample_end(deep_copy_samples, callbacks->begin_deep_copy != nullptr) &&
+      callbacks->end_deep_copy) {
+    sampling_timer _timer{};
+    callbacks->end_deep_copy();
+  }
 }
 
 //----------------------------------------------------------------------------------//
 
 void profile_event(const char* name) {
-  if (callbacks) callbacks->prof_event(name);
+  auto _ts = get_timestamp();
+  dispatch_native(MarkEvents, [name, _ts](native_tool* _tool) {
+    _tool->mark_event(name, _ts);
+  });
+  if (callbacks && callbacks->prof_event && sample_instant()) {
+    sampling_timer _timer{};
+    callbacks->prof_event(name);
+  }
+}
+}  // namespace pykokkos_tools
+
+//----------------------------------------------------------------------------------//
+//
+//  The trampolines are registered with Kokkos while either a python (or C++)
+//  callback was set for the slot or a native tool subscribes to its events
+//
+namespace {
+struct callback_registration {
+  const char* name;
+  uint32_t native_events;
+  void (*enable)(bool);
+  bool callback;
+};
+
+#define TOOL_CALLBACK_REGISTRATION(NAME, FUNC, EVENTS)                     \
+  callback_registration {                                                  \
+    #NAME, EVENTS,                                                         \
+        [](bool _enable) {                                                 \
+          Kokkos::Tools::Experimental::NAME(_enable ? pykokkos_tools::FUNC \
+                                                    : nullptr);            \
+        },                                                                 \
+        false                                                              \
+  }
+
+auto& get_callback_registrations() {
+  using namespace pykokkos_tools;
+  static auto _value = std::array<callback_registration, 23>{
+      TOOL_CALLBACK_REGISTRATION(set_init_callback, init_library, 0),
+      TOOL_CALLBACK_REGISTRATION(set_finalize_callback, finalize_library, 0),
+      TOOL_CALLBACK_REGISTRATION(set_parse_args_callback, parse_args, 0),
+      TOOL_CALLBACK_REGISTRATION(set_print_help_callback, print_help, 0),
+      TOOL_CALLBACK_REGISTRATION(set_begin_parallel_for_callback,
+                                 begin_parallel_for, KernelEvents),
+      TOOL_CALLBACK_REGISTRATION(set_end_parallel_for_callback,
+                                 end_parallel_for, KernelEvents),
+      TOOL_CALLBACK_REGISTRATION(set_begin_parallel_reduce_callback,
+                                 begin_parallel_reduce, KernelEvents),
+      TOOL_CALLBACK_REGISTRATION(set_end_parallel_reduce_callback,
+                                 end_parallel_reduce, KernelEvents),
+      TOOL_CALLBACK_REGISTRATION(set_begin_parallel_scan_callback,
+                                 begin_parallel_scan, KernelEvents),
+      TOOL_CALLBACK_REGISTRATION(set_end_parallel_scan_callback,
+                                 end_parallel_scan, KernelEvents),
+      TOOL_CALLBACK_REGISTRATION(set_push_region_callback, push_profile_region,
+                                 RegionEvents),
+      TOOL_CALLBACK_REGISTRATION(set_pop_region_callback, pop_profile_region,
+                                 RegionEvents),
+      TOOL_CALLBACK_REGISTRATION(set_allocate_data_callback, allocate_data,
+                                 AllocationEvents),
+      TOOL_CALLBACK_REGISTRATION(set_deallocate_data_callback, deallocate_data,
+                                 AllocationEvents),
+      TOOL_CALLBACK_REGISTRATION(set_create_profile_section_callback,
+                                 create_profile_section, SectionEvents),
+      TOOL_CALLBACK_REGISTRATION(set_start_profile_section_callback,
+                                 start_profile_section, SectionEvents),
+      TOOL_CALLBACK_REGISTRATION(set_stop_profile_section_callback,
+                                 stop_profile_section, SectionEvents),
+      TOOL_CALLBACK_REGISTRATION(set_destroy_profile_section_callback,
+                                 destroy_profile_section, SectionEvents),
+      TOOL_CALLBACK_REGISTRATION(set_profile_event_callback, profile_event,
+                                 MarkEvents),
+      TOOL_CALLBACK_REGISTRATION(set_begin_deep_copy_callback, begin_deep_copy,
+                                 DeepCopyEvents),
+      TOOL_CALLBACK_REGISTRATION(set_end_deep_copy_callback, end_deep_copy,
+                                 DeepCopyEvents),
+      TOOL_CALLBACK_REGISTRATION(set_begin_fence_callback, begin_fence,
+                                 FenceEvents),
+      TOOL_CALLBACK_REGISTRATION(set_end_fence_callback, end_fence,
+                                 FenceEvents)};
+  return _value;
+}
+
+#undef TOOL_CALLBACK_REGISTRATION
+
+std::mutex& get_registration_mutex() {
+  static std::mutex _value{};
+  return _value;
+}
+
+void update_registration(callback_registration& _reg) {
+  _reg.enable(_reg.callback || (_reg.native_events & native_events.load()));
+}
+
+void update_native_events() {
+  uint32_t _events = 0;
+  for (auto& itr : get_native_tools()) {
+    if (itr.tool.load()) _events |= itr.events.load();
+  }
+  native_events.store(_events);
+  for (auto& itr : get_callback_registrations()) update_registration(itr);
+}
+
+// invoked when a python or C++ callback is set or cleared
+void set_callback_enabled(const char* _name, bool _enable) {
+  std::lock_guard<std::mutex> _lk{get_registration_mutex()};
+  for (auto& itr : get_callback_registrations()) {
+    if (strcmp(itr.name, _name) == 0) {
+      itr.callback = _enable;
+      update_registration(itr);
+    }
+  }
+}
+}  // namespace
+
+namespace pykokkos_tools {
+void add_native_tool(native_tool* _tool, uint32_t _events) {
+  std::lock_guard<std::mutex> _lk{get_registration_mutex()};
+  native_tool_entry* _entry = nullptr;
+  for (auto& itr : get_native_tools()) {
+    if (itr.tool.load() == _tool) {
+      _entry = &itr;
+      break;
+    }
+    if (!_entry && !itr.tool.load()) _entry = &itr;
+  }
+  if (!_entry) throw std::runtime_error("Error! Too many native tools");
+  _entry->tool.store(_tool);
+  _entry->events.store(_events);
+  update_native_events();
+}
+
+void remove_native_tool(native_tool* _tool) {
+  std::lock_guard<std::mutex> _lk{get_registration_mutex()};
+  for (auto& itr : get_native_tools()) {
+    if (itr.tool.load() == _tool) {
+      itr.events.store(0);
+      itr.tool.store(nullptr);
+    }
+  }
+  update_native_events();
+}
+
+bool has_native_tool(native_tool* _tool) {
+  for (auto& itr : get_native_tools()) {
+    if (itr.tool.load() == _tool) return true;
+  }
+  return false;
 }
 }  // namespace pykokkos_tools
 
@@ -399,36 +897,68 @@ void generate_tools(py::module& kokkos) {
   _tools.def("declare_metadata", &Kokkos::Tools::declareMetadata,
              "Declare some metadata");
 
+  _tools.def(
+      "set_sampling",
+      [](uint64_t _every, py::object _budget) {
+        if (_every == 0) throw py::value_error("Error! every must be non-zero");
+        auto _budget_ns =
+            (_budget.is_none()) ? 0.0 : 1.0e9 * _budget.cast<double>();
+        if (!_budget.is_none() && _budget_ns <= 0.0)
+          throw py::value_error("Error! budget must be positive");
+        sampling.every.store(_every);
+        sampling.budget.store(static_cast<uint64_t>(_budget_ns));
+        sampling.window.store(0);
+        sampling.spent.store(0);
+        sampling.sampled.store(0);
+        sampling.skipped.store(0);
+        ++sampling.generation;
+      },
+      "Sample the python (and C++) callbacks to bound the overhead: kernels "
+      "and fences are forwarded every Nth launch per name and, with a budget, "
+      "the callbacks are skipped once they have taken 'budget' seconds within "
+      "the current second. Begin and end callbacks are always skipped as a "
+      "pair. The native tools receive every event. set_sampling() disables "
+      "sampling",
+      py::arg("every") = 1, py::arg("budget") = py::none{});
+
+  _tools.def(
+      "get_sampling",
+      []() {
+        auto _budget = sampling.budget.load();
+        py::dict _value{};
+        _value["every"]   = sampling.every.load();
+        _value["budget"]  = (_budget == 0) ? py::object{py::none{}}
+                                           : py::object{py::float_(
+                                                 1.0e-9 * _budget)};
+        _value["sampled"] = sampling.sampled.load();
+        _value["skipped"] = sampling.skipped.load();
+        return _value;
+      },
+      "Returns the sampling policy and the number of sampled and skipped "
+      "events since it was set");
+
   //--------------------------------------------------------------------//
   //
   //                           Set functions
   //
   //--------------------------------------------------------------------//
 
-#define TOOL_SET_CALLBACK(NAME, FUNC, REF)                         \
-  _tools.def(                                                      \
-      #NAME,                                                       \
-      [](py::object _func) {                                       \
-        if (!callbacks) return;                                    \
-        pyfunction_wrapper(callbacks->REF, _func);                 \
-        if (_func.is_none()) {                                     \
-          Kokkos::Tools::Experimental::NAME(nullptr);              \
-        } else {                                                   \
-          Kokkos::Tools::Experimental::NAME(pykokkos_tools::FUNC); \
-        }                                                          \
-      },                                                           \
-      "");                                                         \
-  _tools.def(                                                      \
-      #NAME,                                                       \
-      [](decltype(callbacks->REF) _func) {                         \
-        if (!callbacks) return;                                    \
-        cppfunction_wrapper(callbacks->REF, _func);                \
-        if (!_func) {                                              \
-          Kokkos::Tools::Experimental::NAME(nullptr);              \
-        } else {                                                   \
-          Kokkos::Tools::Experimental::NAME(pykokkos_tools::FUNC); \
-        }                                                          \
-      },                                                           \
+#define TOOL_SET_CALLBACK(NAME, FUNC, REF)                     \
+  _tools.def(                                                  \
+      #NAME,                                                   \
+      [](py::object _func) {                                   \
+        if (!callbacks) return;                                \
+        pyfunction_wrapper(callbacks->REF, _func);             \
+        set_callback_enabled(#NAME, !_func.is_none());         \
+      },                                                       \
+      "");                                                     \
+  _tools.def(                                                  \
+      #NAME,                                                   \
+      [](decltype(callbacks->REF) _func) {                     \
+        if (!callbacks) return;                                \
+        cppfunction_wrapper(callbacks->REF, _func);            \
+        set_callback_enabled(#NAME, static_cast<bool>(_func)); \
+      },                                                       \
       "");
 
   TOOL_SET_CALLBACK(set_init_callback, init_library, init)
@@ -465,6 +995,22 @@ void generate_tools(py::module& kokkos) {
   TOOL_SET_CALLBACK(set_end_deep_copy_callback, end_deep_copy, end_deep_copy)
   TOOL_SET_CALLBACK(set_begin_fence_callback, begin_fence, begin_fence)
   TOOL_SET_CALLBACK(set_end_fence_callback, end_fence, end_fence)
+
+#undef TOOL_SET_CALLBACK
+
+  //--------------------------------------------------------------------//
+  //
+  //                           Native tools
+  //
+  //--------------------------------------------------------------------//
+  generate_memory_tracker(_tools);
+  generate_event_recorder(_tools);
+  generate_chrome_trace(_tools);
+  generate_kernel_timer(_tools);
+  generate_perf_counters(_tools);
+  generate_transfer_ledger(_tools);
+  generate_tuning(_tools);
+  generate_regions(_tools);
 }
 
 using execution_space = Kokkos::DefaultHostExecutionSpace;
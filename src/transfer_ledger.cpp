@@ -0,0 +1,276 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "common.hpp"
+#include "tools.hpp"
+
+//----------------------------------------------------------------------------//
+//
+//        Deep copy transfer volume and bandwidth accounting
+//
+//----------------------------------------------------------------------------//
+
+namespace {
+// the time between the begin and end events only covers the transfer when
+// a fence completed it before the end event (e.g. Kokkos::deep_copy without
+// an execution space). Otherwise (e.g. deep_copy_async) it is the time to
+// enqueue the transfer, which is accounted separately and excluded from the
+// bandwidth
+struct transfer_stats {
+  uint64_t count        = 0;
+  uint64_t bytes        = 0;
+  uint64_t fenced       = 0;
+  uint64_t fenced_bytes = 0;
+  uint64_t time         = 0;  // ns of the fenced transfers
+  uint64_t enqueue_time = 0;  // ns of the other transfers
+  uint64_t min_bytes    = std::numeric_limits<uint64_t>::max();
+  uint64_t max_bytes    = 0;
+
+  void record(uint64_t _bytes, uint64_t _time, bool _fenced) {
+    ++count;
+    bytes += _bytes;
+    if (_fenced) {
+      ++fenced;
+      fenced_bytes += _bytes;
+      time += _time;
+    } else {
+      enqueue_time += _time;
+    }
+    min_bytes = std::min(min_bytes, _bytes);
+    max_bytes = std::max(max_bytes, _bytes);
+  }
+
+  // bytes per ns == GB/s
+  double bandwidth() const {
+    return (time > 0) ? static_cast<double>(fenced_bytes) / time : 0.0;
+  }
+};
+
+// bin i holds the transfers of [2^(i-1), 2^i) bytes, bin zero the empty ones
+constexpr size_t num_bins = 65;
+
+size_t get_bin(uint64_t _bytes) {
+  size_t _bin = 0;
+  while (_bytes > 0) {
+    _bytes >>= 1;
+    ++_bin;
+  }
+  return _bin;
+}
+
+uint64_t get_bin_lower(size_t _bin) {
+  return (_bin == 0) ? 0 : (uint64_t{1} << (_bin - 1));
+}
+
+struct size_histogram {
+  std::array<transfer_stats, num_bins> bins = {};
+};
+
+class transfer_ledger : public pykokkos_tools::native_tool {
+ public:
+  using pair_key_t  = std::tuple<std::string, std::string>;
+  using entry_key_t = std::tuple<std::string, std::string, std::string>;
+
+  static transfer_ledger& instance() {
+    return pykokkos_tools::leaked_instance<transfer_ledger>();
+  }
+
+  void begin_deep_copy(const pykokkos_tools::deep_copy_event&) override {
+    get_fenced().emplace_back(false);
+  }
+
+  // a fence completes the transfers of all the deep copies in progress on
+  // the thread
+  void end_kernel(const pykokkos_tools::kernel_event& _event) override {
+    if (_event.kind != pykokkos_tools::Fence) return;
+    auto& _fenced = get_fenced();
+    std::fill(_fenced.begin(), _fenced.end(), true);
+  }
+
+  void end_deep_copy(const pykokkos_tools::deep_copy_event& _event) override {
+    auto& _stack = get_fenced();
+    bool _fenced = !_stack.empty() && _stack.back();
+    if (!_stack.empty()) _stack.pop_back();
+
+    auto _time = (_event.end > _event.begin) ? (_event.end - _event.begin) : 0;
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    m_entries[entry_key_t{_event.src_space, _event.dst_space, _event.dst_label}]
+        .record(_event.size, _time, _fenced);
+    m_histograms[pair_key_t{_event.src_space, _event.dst_space}]
+        .bins.at(get_bin(_event.size))
+        .record(_event.size, _time, _fenced);
+  }
+
+  void reset() {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    m_entries.clear();
+    m_histograms.clear();
+  }
+
+  std::map<entry_key_t, transfer_stats> entries() {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    return m_entries;
+  }
+
+  std::map<pair_key_t, size_histogram> histograms() {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    return m_histograms;
+  }
+
+ private:
+  // whether a fence was observed during each deep copy in progress
+  static std::vector<bool>& get_fenced() {
+    static thread_local std::vector<bool> _fenced{};
+    return _fenced;
+  }
+
+  std::mutex m_mutex                                = {};
+  std::map<entry_key_t, transfer_stats> m_entries   = {};
+  std::map<pair_key_t, size_histogram> m_histograms = {};
+};
+
+py::dict as_dict(const transfer_stats& _stats) {
+  py::dict _value{};
+  _value["count"]           = _stats.count;
+  _value["bytes"]           = _stats.bytes;
+  _value["fenced"]          = _stats.fenced;
+  _value["seconds"]         = 1.0e-9 * _stats.time;
+  _value["enqueue_seconds"] = 1.0e-9 * _stats.enqueue_time;
+  _value["bandwidth"]       = _stats.bandwidth();
+  _value["min_bytes"]       = _stats.min_bytes;
+  _value["max_bytes"]       = _stats.max_bytes;
+  return _value;
+}
+}  // namespace
+
+void generate_transfer_ledger(py::module& tools) {
+  auto _ledger = tools.def_submodule(
+      "transfer_ledger",
+      "Native accounting of the deep copy volume and bandwidth per (source "
+      "space, destination space, label) with histograms of the transfer sizes");
+
+  _ledger.def(
+      "install",
+      []() {
+        auto* _tool = &transfer_ledger::instance();
+        if (pykokkos_tools::has_native_tool(_tool)) return;
+        _tool->reset();
+        // the fences tell the blocking deep copies from the enqueued ones
+        pykokkos_tools::add_native_tool(_tool, pykokkos_tools::DeepCopyEvents |
+                                                   pykokkos_tools::FenceEvents);
+      },
+      "Start recording the deep copies");
+
+  _ledger.def(
+      "uninstall",
+      []() {
+        pykokkos_tools::remove_native_tool(&transfer_ledger::instance());
+      },
+      "Stop recording the deep copies. The results are retained");
+
+  _ledger.def(
+      "installed",
+      []() {
+        return pykokkos_tools::has_native_tool(&transfer_ledger::instance());
+      },
+      "Whether the transfer ledger is installed");
+
+  _ledger.def(
+      "reset", []() { transfer_ledger::instance().reset(); },
+      "Discard the recorded transfers");
+
+  _ledger.def(
+      "results",
+      []() {
+        py::list _value{};
+        for (const auto& itr : transfer_ledger::instance().entries()) {
+          auto _entry         = as_dict(itr.second);
+          _entry["src_space"] = std::get<0>(itr.first);
+          _entry["dst_space"] = std::get<1>(itr.first);
+          _entry["label"]     = std::get<2>(itr.first);
+          _value.append(_entry);
+        }
+        return _value;
+      },
+      "Returns a list of {'src_space', 'dst_space', 'label', 'count', "
+      "'bytes', 'fenced', 'seconds', 'enqueue_seconds', 'bandwidth', "
+      "'min_bytes', 'max_bytes'} where the label is the label of the "
+      "destination view. Only the deep copies completed by a fence before "
+      "they returned ('fenced') contribute to the seconds and the bandwidth "
+      "(in GB/s), the time to enqueue the others (e.g. deep_copy_async) is "
+      "reported as 'enqueue_seconds'");
+
+  _ledger.def(
+      "histograms",
+      []() {
+        py::dict _value{};
+        for (const auto& itr : transfer_ledger::instance().histograms()) {
+          py::list _bins{};
+          for (size_t i = 0; i < num_bins; ++i) {
+            const auto& _stats = itr.second.bins.at(i);
+            if (_stats.count == 0) continue;
+            auto _bin     = as_dict(_stats);
+            _bin["lower"] = get_bin_lower(i);
+            _bin["upper"] = (i + 1 < num_bins)
+                                ? get_bin_lower(i + 1)
+                                : std::numeric_limits<uint64_t>::max();
+            _bins.append(_bin);
+          }
+          _value[py::make_tuple(std::get<0>(itr.first),
+                                std::get<1>(itr.first))] = _bins;
+        }
+        return _value;
+      },
+      "Returns {(src_space, dst_space): [bins]} where each bin holds the "
+      "transfers of [lower, upper) bytes with the same fields as results()");
+}
@@ -0,0 +1,734 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common.hpp"
+#include "tools.hpp"
+
+//----------------------------------------------------------------------------//
+//
+//        Kokkos Tools tuning interface and a built-in tuner
+//
+//----------------------------------------------------------------------------//
+
+namespace {
+namespace kte = Kokkos::Tools::Experimental;
+
+using value_union_t = Kokkos_Tools_VariableValue_ValueUnion;
+
+struct candidate_range {
+  py::object lower = py::none{};
+  py::object upper = py::none{};
+  py::object step  = py::none{};
+  bool open_lower  = false;
+  bool open_upper  = false;
+};
+
+// the types of the variables declared from python, which are needed to
+// convert the python values
+struct declared_variable {
+  std::string name    = {};
+  kte::ValueType type = kte::ValueType::kokkos_value_int64;
+  bool output         = false;
+};
+
+auto& get_declared_variables() {
+  static auto* _value = new std::unordered_map<size_t, declared_variable>{};
+  return *_value;
+}
+
+auto& get_declared_mutex() {
+  static auto* _value = new std::mutex{};
+  return *_value;
+}
+
+kte::VariableValue make_value(size_t _id, kte::ValueType _type,
+                              py::handle _value) {
+  switch (_type) {
+    case kte::ValueType::kokkos_value_double:
+      return kte::make_variable_value(_id, _value.cast<double>());
+    case kte::ValueType::kokkos_value_int64:
+      return kte::make_variable_value(_id, _value.cast<int64_t>());
+    case kte::ValueType::kokkos_value_string:
+      return kte::make_variable_value(_id, _value.cast<std::string>());
+  }
+  throw py::value_error("Error! unknown tuning value type");
+}
+
+py::object get_value(kte::ValueType _type, const value_union_t& _value) {
+  switch (_type) {
+    case kte::ValueType::kokkos_value_double:
+      return py::float_(_value.double_value);
+    case kte::ValueType::kokkos_value_int64:
+      return py::int_(_value.int_value);
+    case kte::ValueType::kokkos_value_string:
+      return py::str(_value.string_value.value);
+  }
+  return py::none{};
+}
+
+std::string to_string(kte::ValueType _type, const value_union_t& _value) {
+  switch (_type) {
+    case kte::ValueType::kokkos_value_double:
+      return std::to_string(_value.double_value);
+    case kte::ValueType::kokkos_value_int64:
+      return std::to_string(_value.int_value);
+    case kte::ValueType::kokkos_value_string:
+      return std::string{_value.string_value.value};
+  }
+  return std::string{};
+}
+
+value_union_t get_union(kte::ValueType _type, py::handle _value) {
+  return make_value(0, _type, _value).value;
+}
+
+// the candidate sets are referenced by Kokkos for the lifetime of the variable
+template <typename Tp>
+Tp* make_persistent(std::vector<Tp>&& _data) {
+  static auto* _storage = new std::deque<std::vector<Tp>>{};
+  std::lock_guard<std::mutex> _lk{get_declared_mutex()};
+  _storage->emplace_back(std::move(_data));
+  return _storage->back().data();
+}
+
+kte::VariableInfo make_variable_info(kte::ValueType _type,
+                                     kte::StatisticalCategory _category,
+                                     py::object _candidates) {
+  auto _info     = kte::VariableInfo{};
+  _info.type     = _type;
+  _info.category = _category;
+
+  if (_candidates.is_none()) {
+    _info.valueQuantity = kte::CandidateValueType::kokkos_value_unbounded;
+  } else if (py::isinstance<candidate_range>(_candidates)) {
+    auto _range         = _candidates.cast<candidate_range>();
+    _info.valueQuantity = kte::CandidateValueType::kokkos_value_range;
+    auto& _value        = _info.candidates.range;
+    _value.lower        = get_union(_type, _range.lower);
+    _value.upper        = get_union(_type, _range.upper);
+    _value.step         = get_union(_type, _range.step);
+    _value.openLower    = _range.open_lower;
+    _value.openUpper    = _range.open_upper;
+  } else {
+    auto _list          = _candidates.cast<py::list>();
+    _info.valueQuantity = kte::CandidateValueType::kokkos_value_set;
+    auto& _value        = _info.candidates.set;
+    _value.size         = _list.size();
+    switch (_type) {
+      case kte::ValueType::kokkos_value_double:
+        _value.values.double_value =
+            make_persistent(_list.cast<std::vector<double>>());
+        break;
+      case kte::ValueType::kokkos_value_int64:
+        _value.values.int_value =
+            make_persistent(_list.cast<std::vector<int64_t>>());
+        break;
+      case kte::ValueType::kokkos_value_string: {
+        auto _strings = std::vector<Kokkos_Tools_Tuning_String>{};
+        for (auto itr : _list) {
+          auto _str = itr.cast<std::string>();
+          _strings.emplace_back();
+          strncpy(_strings.back().value, _str.c_str(),
+                  KOKKOS_TOOLS_TUNING_STRING_LENGTH - 1);
+          _strings.back().value[KOKKOS_TOOLS_TUNING_STRING_LENGTH - 1] = '\0';
+        }
+        _value.values.string_value = make_persistent(std::move(_strings));
+        break;
+      }
+    }
+  }
+  return _info;
+}
+
+size_t declare_type(const std::string& _name, kte::ValueType _type,
+                    kte::StatisticalCategory _category, py::object _candidates,
+                    bool _output) {
+  auto _info = make_variable_info(_type, _category, std::move(_candidates));
+  auto _id   = (_output) ? kte::declare_output_type(_name, _info)
+                         : kte::declare_input_type(_name, _info);
+  std::lock_guard<std::mutex> _lk{get_declared_mutex()};
+  get_declared_variables()[_id] = declared_variable{_name, _type, _output};
+  return _id;
+}
+
+std::vector<kte::VariableValue> make_values(const py::dict& _values) {
+  std::vector<kte::VariableValue> _value{};
+  std::lock_guard<std::mutex> _lk{get_declared_mutex()};
+  for (auto itr : _values) {
+    auto _id   = itr.first.cast<size_t>();
+    auto _vitr = get_declared_variables().find(_id);
+    if (_vitr == get_declared_variables().end())
+      throw py::value_error("Error! tuning variable " + std::to_string(_id) +
+                            " was not declared");
+    _value.emplace_back(make_value(_id, _vitr->second.type, itr.second));
+  }
+  return _value;
+}
+
+//----------------------------------------------------------------------------//
+//
+//        Built-in tuner: grid, random, or epsilon-greedy bandit search over
+//        the candidates of the output variables which minimizes the time
+//        between begin_context and end_context
+//
+//----------------------------------------------------------------------------//
+
+enum class search_strategy { Grid, Random, Bandit };
+
+// ranges are expanded into at most this many candidates
+constexpr size_t max_range_candidates = 1024;
+
+struct tuning_variable {
+  size_t id                             = 0;
+  kte::ValueType type                   = kte::ValueType::kokkos_value_int64;
+  std::vector<value_union_t> candidates = {};
+};
+
+struct config_stats {
+  uint64_t count = 0;
+  uint64_t total = 0;  // ns
+
+  double mean() const { return static_cast<double>(total) / count; }
+};
+
+struct tuning_problem {
+  std::string context                      = {};
+  std::vector<tuning_variable> variables   = {};
+  uint64_t num_configs                     = 1;
+  uint64_t trials                          = 0;
+  std::map<uint64_t, config_stats> configs = {};
+
+  value_union_t get_value(uint64_t _config, size_t _var) const {
+    for (size_t i = 0; i < _var; ++i)
+      _config /= variables.at(i).candidates.size();
+    const auto& _candidates = variables.at(_var).candidates;
+    return _candidates.at(_config % _candidates.size());
+  }
+
+  bool has_best() const { return !configs.empty(); }
+
+  uint64_t get_best() const {
+    auto _best = configs.begin();
+    for (auto itr = configs.begin(); itr != configs.end(); ++itr) {
+      if (itr->second.mean() < _best->second.mean()) _best = itr;
+    }
+    return _best->first;
+  }
+};
+
+std::vector<value_union_t> get_candidates(const kte::VariableInfo& _info) {
+  using value_type = kte::ValueType;
+  std::vector<value_union_t> _value{};
+  if (_info.valueQuantity == kte::CandidateValueType::kokkos_value_set) {
+    const auto& _set = _info.candidates.set;
+    for (size_t i = 0; i < _set.size; ++i) {
+      auto _item = value_union_t{};
+      switch (_info.type) {
+        case value_type::kokkos_value_double:
+          _item.double_value = _set.values.double_value[i];
+          break;
+        case value_type::kokkos_value_int64:
+          _item.int_value = _set.values.int_value[i];
+          break;
+        case value_type::kokkos_value_string:
+          _item.string_value = _set.values.string_value[i];
+          break;
+      }
+      _value.emplace_back(_item);
+    }
+  } else if (_info.valueQuantity ==
+             kte::CandidateValueType::kokkos_value_range) {
+    const auto& _range = _info.candidates.range;
+    if (_info.type == value_type::kokkos_value_int64 &&
+        _range.step.int_value > 0) {
+      auto _step = _range.step.int_value;
+      auto _beg  = _range.lower.int_value + ((_range.openLower) ? _step : 0);
+      for (auto i = _beg; i < _range.upper.int_value ||
+                          (!_range.openUpper && i == _range.upper.int_value);
+           i += _step) {
+        if (_value.size() == max_range_candidates) break;
+        auto _item      = value_union_t{};
+        _item.int_value = i;
+        _value.emplace_back(_item);
+      }
+    } else if (_info.type == value_type::kokkos_value_double &&
+               _range.step.double_value > 0.0) {
+      auto _step = _range.step.double_value;
+      auto _beg  = _range.lower.double_value + ((_range.openLower) ? _step : 0);
+      for (size_t i = 0; i < max_range_candidates; ++i) {
+        auto _v = _beg + i * _step;
+        if (_v > _range.upper.double_value ||
+            (_range.openUpper && _v == _range.upper.double_value))
+          break;
+        auto _item         = value_union_t{};
+        _item.double_value = _v;
+        _value.emplace_back(_item);
+      }
+    }
+  }
+  return _value;
+}
+
+class builtin_tuner {
+ public:
+  static builtin_tuner& instance() {
+    // intentionally leaked: the callbacks may be invoked during finalization
+    static auto* _instance = new builtin_tuner{};
+    return *_instance;
+  }
+
+  void configure(search_strategy _strategy, uint64_t _samples, double _epsilon,
+                 uint64_t _seed) {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    m_strategy = _strategy;
+    m_samples  = _samples;
+    m_epsilon  = _epsilon;
+    m_rng.seed(_seed);
+    m_problems.clear();
+    m_contexts.clear();
+  }
+
+  void declare_variable(const char* _name, size_t _id) {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    m_names[_id] = _name;
+  }
+
+  void begin_context(size_t _context) {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    m_contexts[_context] = active_context{pykokkos_tools::get_timestamp()};
+  }
+
+  void end_context(size_t _context) {
+    auto _end = pykokkos_tools::get_timestamp();
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    auto itr = m_contexts.find(_context);
+    if (itr == m_contexts.end()) return;
+    for (const auto& ritr : itr->second.requests) {
+      auto pitr = m_problems.find(ritr.first);
+      if (pitr == m_problems.end()) continue;
+      auto& _stats = pitr->second.configs[ritr.second];
+      ++_stats.count;
+      _stats.total += _end - itr->second.begin;
+    }
+    m_contexts.erase(itr);
+  }
+
+  void request_values(size_t _context, size_t _ninputs,
+                      const kte::VariableValue* _inputs, size_t _noutputs,
+                      kte::VariableValue* _outputs) {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    // the variables which cannot be enumerated keep their default values
+    std::vector<kte::VariableValue*> _tunable{};
+    std::ostringstream _key{};
+    for (size_t i = 0; i < _noutputs; ++i) {
+      if (!_outputs[i].metadata) continue;
+      _tunable.emplace_back(&_outputs[i]);
+      _key << _outputs[i].type_id << ",";
+    }
+    if (_tunable.empty()) return;
+
+    // each combination of input values is tuned independently
+    _key << "|";
+    for (size_t i = 0; i < _ninputs; ++i) {
+      _key << get_name(_inputs[i].type_id) << "=";
+      if (_inputs[i].metadata)
+        _key << to_string(_inputs[i].metadata->type, _inputs[i].value);
+      _key << ";";
+    }
+
+    auto& _problem = get_problem(_key.str(), _tunable);
+    if (_problem.num_configs == 0) return;
+
+    auto _config = select(_problem);
+    ++_problem.trials;
+    for (size_t i = 0; i < _tunable.size(); ++i)
+      _tunable.at(i)->value = _problem.get_value(_config, i);
+
+    auto itr = m_contexts.find(_context);
+    if (itr != m_contexts.end())
+      itr->second.requests.emplace_back(_key.str(), _config);
+  }
+
+  py::list results() {
+    std::lock_guard<std::mutex> _lk{m_mutex};
+    py::list _value{};
+    for (const auto& itr : m_problems) {
+      const auto& _problem = itr.second;
+      py::list _configs{};
+      for (const auto& citr : _problem.configs) {
+        py::dict _config{};
+        _config["values"] = get_values(_problem, citr.first);
+        _config["count"]  = citr.second.count;
+        _config["mean"]   = 1.0e-9 * citr.second.mean();
+        _configs.append(_config);
+      }
+
+      py::dict _entry{};
+      _entry["context"]        = _problem.context;
+      _entry["trials"]         = _problem.trials;
+      _entry["configurations"] = _configs;
+      _entry["best"]           = (_problem.has_best())
+                                     ? py::object{get_values(
+                                           _problem, _problem.get_best())}
+                                     : py::object{py::none{}};
+      _value.append(_entry);
+    }
+    return _value;
+  }
+
+ private:
+  struct active_context {
+    uint64_t begin                                         = 0;
+    std::vector<std::pair<std::string, uint64_t>> requests = {};
+  };
+
+  std::string get_name(size_t _id) const {
+    auto itr = m_names.find(_id);
+    return (itr != m_names.end()) ? itr->second
+                                  : (std::string{"var_"} + std::to_string(_id));
+  }
+
+  // maps the variable names to the values of a configuration
+  py::dict get_values(const tuning_problem& _problem, uint64_t _config) const {
+    py::dict _values{};
+    for (size_t i = 0; i < _problem.variables.size(); ++i) {
+      const auto& _var = _problem.variables.at(i);
+      _values[get_name(_var.id).c_str()] =
+          get_value(_var.type, _problem.get_value(_config, i));
+    }
+    return _values;
+  }
+
+  tuning_problem& get_problem(const std::string& _key,
+                              const std::vector<kte::VariableValue*>& _vars) {
+    auto itr = m_problems.find(_key);
+    if (itr != m_problems.end()) return itr->second;
+
+    auto _problem    = tuning_problem{};
+    _problem.context = _key.substr(_key.find('|') + 1);
+    for (auto* vitr : _vars) {
+      auto _var       = tuning_variable{};
+      _var.id         = vitr->type_id;
+      _var.type       = vitr->metadata->type;
+      _var.candidates = get_candidates(*vitr->metadata);
+      // saturate rather than overflow for huge search spaces
+      auto _n = static_cast<uint64_t>(_var.candidates.size());
+      if (_n == 0 || _problem.num_configs == 0)
+        _problem.num_configs = 0;
+      else if (_problem.num_configs > std::numeric_limits<uint64_t>::max() / _n)
+        _problem.num_configs = std::numeric_limits<uint64_t>::max();
+      else
+        _problem.num_configs *= _n;
+      _problem.variables.emplace_back(std::move(_var));
+    }
+    return m_problems.emplace(_key, std::move(_problem)).first->second;
+  }
+
+  uint64_t get_random(uint64_t _n) {
+    return std::uniform_int_distribution<uint64_t>{0, _n - 1}(m_rng);
+  }
+
+  uint64_t select(const tuning_problem& _problem) {
+    auto _samples = std::min(m_samples, _problem.num_configs);
+    switch (m_strategy) {
+      case search_strategy::Grid:
+        if (_problem.trials < _samples) return _problem.trials;
+        break;
+      case search_strategy::Random:
+        if (_problem.trials < _samples) return get_random(_problem.num_configs);
+        break;
+      case search_strategy::Bandit: {
+        // explore every (sampled) configuration once, then exploit the best
+        // with probability 1 - epsilon
+        if (_problem.trials < _samples ||
+            std::uniform_real_distribution<double>{0.0, 1.0}(m_rng) <
+                m_epsilon)
+          return get_random(_problem.num_configs);
+        break;
+      }
+    }
+    return (_problem.has_best()) ? _problem.get_best()
+                                 : get_random(_problem.num_configs);
+  }
+
+  std::mutex m_mutex                                    = {};
+  search_strategy m_strategy                            = {};
+  uint64_t m_samples                                    = 64;
+  double m_epsilon                                      = 0.1;
+  std::mt19937_64 m_rng                                 = {};
+  std::unordered_map<size_t, std::string> m_names       = {};
+  std::map<std::string, tuning_problem> m_problems      = {};
+  std::unordered_map<size_t, active_context> m_contexts = {};
+};
+
+namespace tuner_callbacks {
+void declare_output_type(const char* _name, const size_t _id,
+                         kte::VariableInfo*) {
+  builtin_tuner::instance().declare_variable(_name, _id);
+}
+
+void declare_input_type(const char* _name, const size_t _id,
+                        kte::VariableInfo*) {
+  builtin_tuner::instance().declare_variable(_name, _id);
+}
+
+void request_output_values(const size_t _context, const size_t _ninputs,
+                           const kte::VariableValue* _inputs,
+                           const size_t _noutputs,
+                           kte::VariableValue* _outputs) {
+  builtin_tuner::instance().request_values(_context, _ninputs, _inputs,
+                                           _noutputs, _outputs);
+}
+
+void begin_context(const size_t _context) {
+  builtin_tuner::instance().begin_context(_context);
+}
+
+void end_context(const size_t _context, kte::VariableValue) {
+  builtin_tuner::instance().end_context(_context);
+}
+}  // namespace tuner_callbacks
+
+bool tuner_installed = false;
+
+void set_tuner_callbacks(bool _enable) {
+  namespace cb = tuner_callbacks;
+  kte::set_declare_output_type_callback(_enable ? cb::declare_output_type
+                                                : nullptr);
+  kte::set_declare_input_type_callback(_enable ? cb::declare_input_type
+                                               : nullptr);
+  kte::set_request_output_values_callback(_enable ? cb::request_output_values
+                                                  : nullptr);
+  kte::set_begin_context_callback(_enable ? cb::begin_context : nullptr);
+  kte::set_end_context_callback(_enable ? cb::end_context : nullptr);
+  tuner_installed = _enable;
+}
+}  // namespace
+
+void generate_tuning(py::module& tools) {
+  auto _tuning = tools.def_submodule(
+      "tuning",
+      "Kokkos Tools tuning interface (input/output variables and contexts) "
+      "and a built-in tuner");
+
+  //--------------------------------------------------------------------//
+  //
+  //                           Enumerations
+  //
+  //--------------------------------------------------------------------//
+  py::enum_<kte::ValueType> _type(_tuning, "value_type",
+                                  "Type of a tuning variable");
+  _type.value("double", kte::ValueType::kokkos_value_double)
+      .value("int64", kte::ValueType::kokkos_value_int64)
+      .value("string", kte::ValueType::kokkos_value_string);
+
+  py::enum_<kte::StatisticalCategory> _category(
+      _tuning, "statistical_category",
+      "Statistical category of a tuning variable");
+  _category
+      .value("categorical", kte::StatisticalCategory::kokkos_value_categorical)
+      .value("ordinal", kte::StatisticalCategory::kokkos_value_ordinal)
+      .value("interval", kte::StatisticalCategory::kokkos_value_interval)
+      .value("ratio", kte::StatisticalCategory::kokkos_value_ratio);
+
+  py::enum_<search_strategy> _strategy(_tuning, "search_strategy",
+                                       "Search strategy of the built-in tuner");
+  _strategy.value("grid", search_strategy::Grid)
+      .value("random", search_strategy::Random)
+      .value("bandit", search_strategy::Bandit);
+
+  py::class_<candidate_range> _range(_tuning, "candidate_range",
+                                     "Range of candidate values");
+  _range.def(py::init([](py::object _lower, py::object _upper,
+                         py::object _step, bool _open_lower,
+                         bool _open_upper) {
+               return new candidate_range{_lower, _upper, _step, _open_lower,
+                                          _open_upper};
+             }),
+             "Values in [lower, upper] by step. The bounds are excluded when "
+             "open",
+             py::arg("lower"), py::arg("upper"), py::arg("step"),
+             py::arg("open_lower") = false, py::arg("open_upper") = false);
+  _range.def_readonly("lower", &candidate_range::lower)
+      .def_readonly("upper", &candidate_range::upper)
+      .def_readonly("step", &candidate_range::step)
+      .def_readonly("open_lower", &candidate_range::open_lower)
+      .def_readonly("open_upper", &candidate_range::open_upper);
+
+  //--------------------------------------------------------------------//
+  //
+  //                           Functions
+  //
+  //--------------------------------------------------------------------//
+  _tuning.def(
+      "tuning_enabled",
+      []() {
+#if defined(KOKKOS_ENABLE_TUNING)
+        return true;
+#else
+        return false;
+#endif
+      },
+      "Whether Kokkos was configured with Kokkos_ENABLE_TUNING, which is "
+      "required for the tuning callbacks to be invoked");
+
+  _tuning.def(
+      "declare_input_type",
+      [](const std::string& _name, kte::ValueType _type,
+         kte::StatisticalCategory _category, py::object _candidates) {
+        return declare_type(_name, _type, _category, _candidates, false);
+      },
+      "Declare an input (context) variable and return its id",
+      py::arg("name"), py::arg("type"),
+      py::arg("category") = kte::StatisticalCategory::kokkos_value_categorical,
+      py::arg("candidates") = py::none{});
+
+  _tuning.def(
+      "declare_output_type",
+      [](const std::string& _name, kte::ValueType _type,
+         kte::StatisticalCategory _category, py::object _candidates) {
+        return declare_type(_name, _type, _category, _candidates, true);
+      },
+      "Declare an output (tuned) variable and return its id. The candidates "
+      "are a list of values, a candidate_range, or None (unbounded)",
+      py::arg("name"), py::arg("type"),
+      py::arg("category") = kte::StatisticalCategory::kokkos_value_categorical,
+      py::arg("candidates") = py::none{});
+
+  _tuning.def("get_new_context_id", &kte::get_new_context_id,
+              "Returns a new context id");
+
+  _tuning.def("get_current_context_id", &kte::get_current_context_id,
+              "Returns the id of the current context");
+
+  _tuning.def("begin_context", &kte::begin_context, "Begin a tuning context",
+              py::arg("context"));
+
+  _tuning.def("end_context", &kte::end_context,
+              "End a tuning context. The tuner measures the time since the "
+              "beginning of the context",
+              py::arg("context"));
+
+  _tuning.def(
+      "set_input_values",
+      [](size_t _context, const py::dict& _values) {
+        auto _vars = make_values(_values);
+        kte::set_input_values(_context, _vars.size(), _vars.data());
+      },
+      "Set the values of input variables in a context from {id: value}",
+      py::arg("context"), py::arg("values"));
+
+  _tuning.def(
+      "request_output_values",
+      [](size_t _context, const py::dict& _defaults) {
+        auto _vars = make_values(_defaults);
+        kte::request_output_values(_context, _vars.size(), _vars.data());
+        py::dict _value{};
+        std::lock_guard<std::mutex> _lk{get_declared_mutex()};
+        for (const auto& itr : _vars) {
+          auto _type = get_declared_variables().at(itr.type_id).type;
+          _value[py::int_(itr.type_id)] = get_value(_type, itr.value);
+        }
+        return _value;
+      },
+      "Request values for the output variables in a context. Takes "
+      "{id: default value} and returns {id: value}, where the defaults are "
+      "returned when no tuning tool is loaded",
+      py::arg("context"), py::arg("defaults"));
+
+  //--------------------------------------------------------------------//
+  //
+  //                           Built-in tuner
+  //
+  //--------------------------------------------------------------------//
+  _tuning.def(
+      "install",
+      [](search_strategy _strategy, uint64_t _samples, double _epsilon,
+         uint64_t _seed) {
+        if (_samples == 0)
+          throw py::value_error("Error! samples must be non-zero");
+        builtin_tuner::instance().configure(_strategy, _samples, _epsilon,
+                                            _seed);
+        set_tuner_callbacks(true);
+      },
+      "Install the built-in tuner, which minimizes the time between "
+      "begin_context and end_context. 'grid' evaluates the first 'samples' "
+      "configurations in order, 'random' evaluates 'samples' random "
+      "configurations, and 'bandit' explores 'samples' random configurations "
+      "and then a random one with probability 'epsilon'. Afterwards the "
+      "fastest configuration is used. Only variables with a candidate set or "
+      "a range with a step are tuned. Installing resets the tuner",
+      py::arg("strategy") = search_strategy::Bandit, py::arg("samples") = 64,
+      py::arg("epsilon") = 0.1, py::arg("seed") = 0);
+
+  _tuning.def(
+      "uninstall", []() { set_tuner_callbacks(false); },
+      "Remove the built-in tuner. The results are retained");
+
+  _tuning.def(
+      "installed", []() { return tuner_installed; },
+      "Whether the built-in tuner is installed");
+
+  _tuning.def(
+      "results", []() { return builtin_tuner::instance().results(); },
+      "Returns a list of {'context', 'trials', 'best', 'configurations'} per "
+      "combination of output variables and input values, where 'best' and "
+      "the configuration 'values' map the variable names to the values and "
+      "the configuration 'mean' is in seconds");
+}
@@ -0,0 +1,262 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include "view_cache.hpp"
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "common.hpp"
+#include "libpykokkos.hpp"
+
+namespace view_cache {
+namespace {
+using entry_ptr_t = std::unique_ptr<entry_base>;
+
+// free bytes retained per memory space unless changed via set_limit
+constexpr size_t default_limit = size_t{1} << 30;
+
+struct space_cache {
+  std::string label      = {};
+  size_t allocated       = 0;
+  size_t high_water_mark = 0;
+  size_t hits            = 0;
+  size_t misses          = 0;
+
+  std::map<size_t, std::vector<entry_ptr_t>> bins = {};
+
+  size_t in_use() const {
+    size_t _sum = 0;
+    for (const auto &bitr : bins)
+      for (const auto &eitr : bitr.second)
+        if (eitr->in_use()) _sum += bitr.first;
+    return _sum;
+  }
+
+  // moves the free entries, largest first, into _released until no more than
+  // _keep bytes are free and returns the number of bytes released. The
+  // entries are destroyed by the caller after the cache lock is released
+  size_t release(size_t _keep, std::vector<entry_ptr_t> &_released) {
+    size_t _free = allocated - in_use();
+    size_t _sum  = 0;
+    for (auto bitr = bins.rbegin(); bitr != bins.rend() && _free > _keep;) {
+      auto &_entries = bitr->second;
+      for (auto eitr = _entries.begin();
+           eitr != _entries.end() && _free > _keep;) {
+        if ((*eitr)->in_use()) {
+          ++eitr;
+        } else {
+          _sum += bitr->first;
+          _free -= bitr->first;
+          _released.emplace_back(std::move(*eitr));
+          eitr = _entries.erase(eitr);
+        }
+      }
+      if (_entries.empty())
+        bitr = decltype(bitr){bins.erase(std::next(bitr).base())};
+      else
+        ++bitr;
+    }
+    allocated -= _sum;
+    return _sum;
+  }
+};
+
+struct cache_state {
+  std::atomic<bool> enabled = {false};
+  std::mutex mutex          = {};
+  size_t limit              = default_limit;
+
+  std::map<size_t, space_cache> spaces = {};
+};
+
+cache_state &get_state() {
+  // intentionally leaked: the views are released by finalize_view_cache()
+  // before Kokkos is finalized, not during static destruction
+  static auto *_instance = new cache_state{};
+  return *_instance;
+}
+
+// releases the free entries of the given memory space (or all of them) beyond
+// _keep bytes and returns the number of bytes released
+size_t release(py::object _space, size_t _keep) {
+  auto &_state   = get_state();
+  auto _sum      = size_t{0};
+  auto _released = std::vector<entry_ptr_t>{};
+  {
+    std::lock_guard<std::mutex> _lk{_state.mutex};
+    for (auto &itr : _state.spaces) {
+      if (_space.is_none() || _space.cast<KokkosMemorySpace>() == itr.first)
+        _sum += itr.second.release(_keep, _released);
+    }
+  }
+  // the released views are deallocated after the lock is released
+  _released.clear();
+  return _sum;
+}
+}  // namespace
+
+bool enabled() { return get_state().enabled.load(std::memory_order_relaxed); }
+
+bool acquire(size_t _space, size_t _bytes, std::type_index _type,
+             const acquire_func_t &_func) {
+  auto &_state = get_state();
+  std::lock_guard<std::mutex> _lk{_state.mutex};
+  auto &_cache = _state.spaces[_space];
+  // larger allocations are only reused up to twice the requested size
+  auto _end = _cache.bins.upper_bound(2 * _bytes);
+  for (auto bitr = _cache.bins.lower_bound(_bytes); bitr != _end; ++bitr) {
+    for (auto &itr : bitr->second) {
+      if (itr->type == _type && !itr->in_use() && _func(itr.get())) {
+        ++_cache.hits;
+        return true;
+      }
+    }
+  }
+  ++_cache.misses;
+  return false;
+}
+
+void insert(size_t _space, const std::string &_space_label,
+            std::unique_ptr<entry_base> &&_entry) {
+  auto &_state   = get_state();
+  auto _released = std::vector<entry_ptr_t>{};
+  {
+    std::lock_guard<std::mutex> _lk{_state.mutex};
+    auto &_cache = _state.spaces[_space];
+    auto _bytes  = _entry->bytes;
+    _cache.label = _space_label;
+    _cache.bins[_bytes].emplace_back(std::move(_entry));
+    _cache.allocated += _bytes;
+    _cache.high_water_mark = std::max(_cache.high_water_mark, _cache.allocated);
+    _cache.release(_state.limit, _released);
+  }
+}
+}  // namespace view_cache
+
+//----------------------------------------------------------------------------//
+
+void finalize_view_cache() {
+  auto &_state   = view_cache::get_state();
+  auto _released = std::map<size_t, view_cache::space_cache>{};
+  {
+    std::lock_guard<std::mutex> _lk{_state.mutex};
+    std::swap(_released, _state.spaces);
+  }
+}
+
+void generate_view_cache(py::module &kokkos) {
+  auto _allocator = kokkos.def_submodule(
+      "allocator", "Caching allocator for views constructed from python");
+
+  _allocator.def(
+      "enable",
+      [](bool _enable) {
+        view_cache::get_state().enabled.store(_enable);
+        if (!_enable) finalize_view_cache();
+      },
+      py::arg("enable") = true,
+      "Enable or disable serving managed view allocations from the cache. "
+      "Disabling releases the cached allocations which are no longer in use "
+      "by python");
+
+  _allocator.def("enabled", &view_cache::enabled,
+                 "Whether the caching allocator is enabled");
+
+  _allocator.def(
+      "trim",
+      [](py::object _space) { return view_cache::release(_space, 0); },
+      py::arg("space") = py::none(),
+      "Release the cached allocations which are not in use (optionally only "
+      "for the given memory space). Returns the number of bytes released");
+
+  _allocator.def(
+      "set_limit",
+      [](size_t _limit) {
+        auto &_state = view_cache::get_state();
+        {
+          std::lock_guard<std::mutex> _lk{_state.mutex};
+          _state.limit = _limit;
+        }
+        view_cache::release(py::none{}, _limit);
+      },
+      py::arg("bytes"),
+      "Set the number of bytes of free allocations retained per memory space "
+      "(default: 1 GiB). Free allocations beyond the limit are released");
+
+  _allocator.def(
+      "get_limit",
+      []() {
+        auto &_state = view_cache::get_state();
+        std::lock_guard<std::mutex> _lk{_state.mutex};
+        return _state.limit;
+      },
+      "Number of bytes of free allocations retained per memory space");
+
+  _allocator.def(
+      "statistics",
+      []() {
+        auto &_state = view_cache::get_state();
+        std::lock_guard<std::mutex> _lk{_state.mutex};
+        py::dict _stats{};
+        for (auto &itr : _state.spaces) {
+          auto &_cache = itr.second;
+          if (_cache.label.empty()) continue;
+          auto _allocated = _cache.allocated;
+          auto _in_use    = _cache.in_use();
+          py::dict _entry{};
+          _entry["in_use"]             = _in_use;
+          _entry["cached"]             = _allocated - _in_use;
+          _entry["high_water_mark"]    = _cache.high_water_mark;
+          _entry["hits"]               = _cache.hits;
+          _entry["misses"]             = _cache.misses;
+          _stats[_cache.label.c_str()] = _entry;
+        }
+        return _stats;
+      },
+      "Bytes in use, bytes cached, high-water mark of the bytes allocated, "
+      "hits, and misses per memory space");
+}
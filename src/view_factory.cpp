@@ -0,0 +1,142 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include "view_factory.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <sstream>
+#include <vector>
+
+#include "common.hpp"
+#include "libpykokkos.hpp"
+
+namespace view_factory {
+namespace {
+static constexpr size_t RankSlots = ViewDataMaxDimensions + 1;
+static constexpr size_t TableSize = ViewDataTypesEnd * MemorySpacesEnd *
+                                    MemoryLayoutEnd * MemoryTraitEnd *
+                                    RankSlots;
+
+struct factory_table {
+  // index into entries (-1 when the variant was not generated)
+  std::vector<int32_t> index = std::vector<int32_t>(TableSize, -1);
+  std::vector<entry> entries = {};
+};
+
+factory_table &get_table() {
+  static auto *_instance = new factory_table{};
+  return *_instance;
+}
+}  // namespace
+
+size_t get_index(size_t _dtype, size_t _space, size_t _layout, size_t _trait,
+                 size_t _rank) {
+  return (((_dtype * MemorySpacesEnd + _space) * MemoryLayoutEnd + _layout) *
+              MemoryTraitEnd +
+          _trait) *
+             RankSlots +
+         _rank;
+}
+
+void add_entry(size_t _index, entry &&_entry) {
+  auto &_table = get_table();
+  if (_table.index.at(_index) >= 0) return;
+  _table.index.at(_index) = static_cast<int32_t>(_table.entries.size());
+  _table.entries.emplace_back(std::move(_entry));
+}
+}  // namespace view_factory
+
+void generate_view_factory(py::module &kokkos) {
+  kokkos.def(
+      "make_view",
+      [kokkos](KokkosViewDataType _dtype, KokkosMemorySpace _space,
+               KokkosMemoryLayoutType _layout, py::object _trait_obj,
+               size_t _rank, const std::vector<size_t> &_shape,
+               const std::optional<std::string> &_label, bool _initialize,
+               bool _dynamic) mutable -> py::object {
+        // same as kokkos.array: an unmanaged trait without an array
+        // allocates a managed view
+        auto _trait = (_trait_obj.is_none())
+                          ? Managed
+                          : _trait_obj.cast<KokkosMemoryTrait>();
+        if (_trait == Unmanaged) _trait = Managed;
+
+        if (!_dynamic && _rank != _shape.size()) {
+          std::stringstream ss;
+          ss << "Error! rank " << _rank << " does not match the "
+             << _shape.size() << " extents of the shape";
+          throw py::value_error{ss.str()};
+        }
+
+        if (!_dynamic && (_rank == 0 || _rank > ViewDataMaxDimensions)) {
+          std::stringstream ss;
+          ss << "pykokkos-base build only supports " << ViewDataMaxDimensions
+             << " ranks. Requested " << _rank << " ranks";
+          throw py::value_error{ss.str()};
+        }
+
+        auto &_table = view_factory::get_table();
+        auto _index  = view_factory::get_index(
+            _dtype, _space, _layout, _trait,
+            (_dynamic) ? view_factory::DynamicRankIdx : _rank - 1);
+        auto _entry_idx = _table.index.at(_index);
+        if (_entry_idx < 0)
+          throw py::value_error(
+              "Error! The requested view type is not available in this "
+              "build of pykokkos-base");
+
+        const auto &_entry = _table.entries.at(_entry_idx);
+        // the python class might not have been created yet
+        if (lazy_registration()) register_lazy_pyclass(kokkos, *_entry.type);
+        return _entry.create(_label.value_or(_entry.label), _shape,
+                             _initialize);
+      },
+      py::arg("dtype"), py::arg("space"), py::arg("layout"), py::arg("trait"),
+      py::arg("rank"), py::arg("shape"), py::arg("label") = py::none(),
+      py::arg("initialize") = true, py::arg("dynamic") = false,
+      "Create a managed view from the data type, memory space, layout, "
+      "memory trait, rank, and extents without looking up the class by name. "
+      "The rank is ignored for a dynamic rank view");
+}
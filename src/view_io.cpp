@@ -0,0 +1,258 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include "view_io.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "libpykokkos.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+namespace view_io {
+namespace {
+#if defined(__unix__) || defined(__APPLE__)
+std::string get_error(const std::string &_msg, const std::string &_path) {
+  return "Error! " + _msg + " '" + _path + "': " + std::strerror(errno);
+}
+
+// pwrite/pread in blocks until every byte is transferred
+template <typename FuncT, typename PtrT>
+void transfer_all(FuncT &&_func, int _fd, PtrT _ptr, size_t _bytes,
+                  size_t _offset, const std::string &_path, const char *_op) {
+  while (_bytes > 0) {
+    auto _n = _func(_fd, _ptr, std::min(_bytes, block_size),
+                    static_cast<off_t>(_offset));
+    if (_n < 0 && errno == EINTR) continue;
+    if (_n < 0) throw std::runtime_error(get_error(_op, _path));
+    if (_n == 0)
+      throw std::runtime_error("Error! Unexpected end of file in '" + _path +
+                               "'");
+    _ptr += _n;
+    _bytes -= _n;
+    _offset += _n;
+  }
+}
+
+bool is_aligned(const void *_data) {
+  return reinterpret_cast<uintptr_t>(_data) % alignment == 0;
+}
+#endif
+
+template <size_t... Idx>
+size_t get_dtype_size(uint32_t _dtype, std::index_sequence<Idx...>) {
+  constexpr size_t _sizes[] = {
+      sizeof(typename ViewDataTypeSpecialization<Idx>::type)...};
+  return _sizes[_dtype];
+}
+}  // namespace
+
+#if defined(__unix__) || defined(__APPLE__)
+file::file(const std::string &_path, bool _write, bool _direct)
+    : m_path{_path} {
+  int _flags = (_write) ? (O_WRONLY | O_CREAT | O_TRUNC) : O_RDONLY;
+  m_fd       = ::open(m_path.c_str(), _flags, 0644);
+  if (m_fd < 0) throw std::runtime_error(get_error("Unable to open", m_path));
+#  if defined(O_DIRECT)
+  // file systems without O_DIRECT support (e.g. tmpfs) use buffered I/O
+  if (_direct)
+    m_direct_fd = ::open(m_path.c_str(), (_flags & ~O_TRUNC) | O_DIRECT, 0644);
+#  else
+  consume_parameters(_direct);
+#  endif
+}
+
+file::~file() {
+  if (m_direct_fd >= 0) ::close(m_direct_fd);
+  if (m_fd >= 0) ::close(m_fd);
+  std::free(m_block);
+}
+
+char *file::get_block(size_t _bytes) {
+  _bytes = std::min(_bytes, block_size);
+  if (m_block_size < _bytes) {
+    std::free(m_block);
+    m_block      = nullptr;
+    m_block_size = 0;
+    if (::posix_memalign(&m_block, alignment, _bytes) != 0)
+      throw std::bad_alloc{};
+    m_block_size = _bytes;
+  }
+  return static_cast<char *>(m_block);
+}
+
+void file::write_header(const header &_header, const std::string &_label) {
+  auto _value       = _header;
+  auto _label_size  = std::min(_label.size(), data_offset - sizeof(header));
+  _value.label_size = _label_size;
+  transfer_all(::pwrite, m_fd, reinterpret_cast<const char *>(&_value),
+               sizeof(header), 0, m_path, "Unable to write");
+  transfer_all(::pwrite, m_fd, _label.data(), _label_size, sizeof(header),
+               m_path, "Unable to write");
+}
+
+header file::read_header(std::string &_label) {
+  auto _value = header{};
+  transfer_all(::pread, m_fd, reinterpret_cast<char *>(&_value),
+               sizeof(header), 0, m_path, "Unable to read");
+  if (std::memcmp(_value.magic, header{}.magic, sizeof(header{}.magic)) != 0)
+    throw py::value_error("Error! '" + m_path + "' is not a saved view");
+  if (_value.version != format_version)
+    throw py::value_error("Error! '" + m_path +
+                          "' has an unsupported format version " +
+                          std::to_string(_value.version));
+  if (_value.dtype >= static_cast<uint32_t>(ViewDataTypesEnd))
+    throw py::value_error("Error! '" + m_path + "' has an unknown data type " +
+                          std::to_string(_value.dtype));
+  if (_value.rank > 8)
+    throw py::value_error("Error! '" + m_path + "' has an invalid rank " +
+                          std::to_string(_value.rank));
+  if (_value.label_size > data_offset - sizeof(header))
+    throw py::value_error("Error! '" + m_path +
+                          "' has an invalid label size " +
+                          std::to_string(_value.label_size));
+  auto _data_size = get_dtype_size(
+      _value.dtype, std::make_index_sequence<ViewDataTypesEnd>{});
+  for (uint32_t i = 0; i < _value.rank; ++i)
+    _data_size *= _value.extents[i];
+  if (_value.data_size != _data_size)
+    throw py::value_error("Error! '" + m_path + "' has a data size of " +
+                          std::to_string(_value.data_size) +
+                          " bytes but its shape requires " +
+                          std::to_string(_data_size) + " bytes");
+  _label.resize(_value.label_size);
+  transfer_all(::pread, m_fd, &_label[0], _label.size(), sizeof(header),
+               m_path, "Unable to read");
+  return _value;
+}
+
+void file::write(const void *_data, size_t _bytes, size_t _offset) {
+  auto _ptr     = static_cast<const char *>(_data);
+  auto _aligned = (m_direct_fd < 0) ? size_t{0} : _bytes - _bytes % alignment;
+  if (_aligned > 0 && is_aligned(_ptr)) {
+    transfer_all(::pwrite, m_direct_fd, _ptr, _aligned, _offset, m_path,
+                 "Unable to write");
+  } else if (_aligned > 0) {
+    // O_DIRECT from an unaligned allocation goes through an aligned block
+    auto *_block = get_block(_aligned);
+    for (size_t i = 0; i < _aligned; i += m_block_size) {
+      auto _n = std::min(m_block_size, _aligned - i);
+      std::memcpy(_block, _ptr + i, _n);
+      transfer_all(::pwrite, m_direct_fd, _block, _n, _offset + i, m_path,
+                   "Unable to write");
+    }
+  }
+  transfer_all(::pwrite, m_fd, _ptr + _aligned, _bytes - _aligned,
+               _offset + _aligned, m_path, "Unable to write");
+}
+
+void file::read(void *_data, size_t _bytes, size_t _offset) {
+  auto _ptr     = static_cast<char *>(_data);
+  auto _aligned = (m_direct_fd < 0) ? size_t{0} : _bytes - _bytes % alignment;
+  if (_aligned > 0 && is_aligned(_ptr)) {
+    transfer_all(::pread, m_direct_fd, _ptr, _aligned, _offset, m_path,
+                 "Unable to read");
+  } else if (_aligned > 0) {
+    auto *_block = get_block(_aligned);
+    for (size_t i = 0; i < _aligned; i += m_block_size) {
+      auto _n = std::min(m_block_size, _aligned - i);
+      transfer_all(::pread, m_direct_fd, _block, _n, _offset + i, m_path,
+                   "Unable to read");
+      std::memcpy(_ptr + i, _block, _n);
+    }
+  }
+  transfer_all(::pread, m_fd, _ptr + _aligned, _bytes - _aligned,
+               _offset + _aligned, m_path, "Unable to read");
+}
+#else
+file::file(const std::string &_path, bool, bool) : m_path{_path} {
+  throw std::runtime_error(
+      "Error! Saving and loading views is not supported on this platform");
+}
+
+file::~file() = default;
+
+void file::write_header(const header &, const std::string &) {}
+header file::read_header(std::string &) { return header{}; }
+void file::write(const void *, size_t, size_t) {}
+void file::read(void *, size_t, size_t) {}
+#endif
+
+header read_header(const std::string &_path, std::string &_label) {
+  file _file{_path, false, false};
+  return _file.read_header(_label);
+}
+}  // namespace view_io
+
+void generate_view_io(py::module &kokkos) {
+  kokkos.def(
+      "read_view_header",
+      [](const std::string &_path) {
+        std::string _label{};
+        auto _header = view_io::read_header(_path, _label);
+
+        py::dict _info{};
+        _info["dtype"]   = static_cast<KokkosViewDataType>(_header.dtype);
+        _info["layout"]  = static_cast<KokkosMemoryLayoutType>(_header.layout);
+        _info["rank"]    = _header.rank;
+        _info["dynamic"] = (_header.dynamic != 0);
+        _info["label"]   = _label;
+        py::list _shape{};
+        for (uint32_t i = 0; i < _header.rank; ++i)
+          _shape.append(_header.extents[i]);
+        _info["shape"] = _shape;
+        return _info;
+      },
+      "Read the data type, layout, rank, shape, and label of a saved view",
+      py::arg("path"));
+}